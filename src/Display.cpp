@@ -1,20 +1,588 @@
 #include "Display.h"
 #include "DisplayNode.h"
 #include "DisplayNodeWalker.h"
+#include "InvalidOperationException.h"
+#include "LayoutPool.h"
+#include "LayoutTask.h"
 #include "Parser.h"
 #include "Stylesheet.h"
 #include "Tokenizer.h"
 #include "TokenizerStream.h"
 
-#include <queue>
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <iostream>
 
-using std::queue;
 using std::string;
+using std::vector;
+using std::min;
 
 namespace Dezel {
 
+Display::~Display()
+{
+	/*
+	 * The nodes can be deleted after the display. The ones it still keeps
+	 * track of are detached so they do not reach back to it once deleted.
+	 */
+
+	for (auto node : this->journal) {
+		node->changes = kDisplayNodeChangeNone;
+		node->display = nullptr;
+	}
+
+	for (auto node : this->boundaries) {
+		node->scheduled = false;
+		node->display = nullptr;
+	}
+
+	for (auto& snapshot : this->traitBatch) {
+		snapshot.node->batchedTraits = false;
+		snapshot.node->display = nullptr;
+	}
+
+	for (auto node : this->styled) {
+		if (node) {
+			node->pendingTraits = false;
+			node->display = nullptr;
+		}
+	}
+
+	if (this->stylesheet) {
+		this->stylesheet->release();
+	}
+
+	delete this->pool;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+void
+Display::resolveStyles()
+{
+	if (this->stylesheet == nullptr) {
+		return;
+	}
+
+	/*
+	 * The nodes which traits are invalid are gathered in tree order along
+	 * the same paths the layout will visit, from the window then from the
+	 * scheduled boundaries. The children of a virtualized node are left to
+	 * the layout, only the ones in view will be styled.
+	 */
+
+	auto gather = [this](DisplayNode* root) {
+
+		this->walker.visit(root, [this, root](DisplayNode* node) {
+
+			if (node != root &&
+				node->invalid == false &&
+				node->invalidDescendant == false) {
+				return false;
+			}
+
+			if (node != root &&
+				node->offscreen) {
+				return false;
+			}
+
+			if (node->invalidTraits &&
+				node->pendingTraits == false) {
+				node->pendingTraits = true;
+				this->styled.push_back(node);
+			}
+
+			return node->isVirtualized() == false;
+		});
+	};
+
+	gather(this->window);
+
+	for (auto boundary : this->boundaries) {
+
+		/*
+		 * The same boundaries as the layout are skipped, an invalid one is
+		 * reached from the window and the ones out of the tree or out of
+		 * view are not resolved.
+		 */
+
+		if (boundary->invalid ||
+			boundary->invalidDescendant == false) {
+			continue;
+		}
+
+		auto root = boundary;
+		auto offscreen = boundary->offscreen;
+
+		while (root->parent) {
+			root = root->parent;
+			offscreen = offscreen || root->offscreen;
+		}
+
+		if (root != this->window ||
+			offscreen) {
+			continue;
+		}
+
+		gather(boundary);
+	}
+
+	/*
+	 * Matching only reads the stylesheet and the traits of the nodes and
+	 * their ancestors, no callback is invoked. Consecutive nodes are matched
+	 * by the same task so its ancestor filter and style cache are reused.
+	 */
+
+	const size_t chunk = 64;
+
+	const auto count = this->styled.size();
+
+	if (this->pool == nullptr ||
+		count < chunk * 2) {
+
+		for (auto node : this->styled) {
+			node->pendingProperties = node->matchTraits();
+		}
+
+	} else {
+
+		vector<LayoutTask*> tasks;
+
+		LayoutGroup group;
+
+		for (size_t beg = 0; beg < count; beg += chunk) {
+
+			auto end = min(beg + chunk, count);
+
+			auto task = new LayoutTask(this->styled[beg]);
+
+			this->pool->submit(group, [this, task, beg, end] {
+				task->run([this, beg, end] {
+					for (auto i = beg; i < end; i++) {
+						auto node = this->styled[i];
+						node->pendingProperties = node->matchTraits();
+					}
+				});
+			});
+
+			tasks.push_back(task);
+		}
+
+		this->wait(group, tasks);
+
+		for (auto task : tasks) {
+			this->join(task);
+			delete task;
+		}
+	}
+
+	/*
+	 * The properties are applied in tree order on the calling thread. A
+	 * callback may change the traits of a node that was matched already, in
+	 * which case the node is matched again.
+	 */
+
+	auto matched = this->traitsVersion.load();
+
+	for (size_t i = 0; i < this->styled.size(); i++) {
+
+		auto node = this->styled[i];
+
+		if (node == nullptr) {
+			continue;
+		}
+
+		/*
+		 * The ancestor filter and the style cache were filled before the
+		 * callbacks changed any traits, they are reset before a node is
+		 * matched again.
+		 */
+
+		const auto version = this->traitsVersion.load();
+
+		if (node->pendingProperties == nullptr &&
+			version != matched) {
+			matched = version;
+			this->filter.sync(nullptr, version);
+			this->styleCache.sync(version);
+		}
+
+		node->pendingTraits = false;
+		node->resolveTraits();
+	}
+
+	this->styled.clear();
+}
+
+void
+Display::resolveTree(DisplayNode* root, DisplayNodeWalker& walker, vector<DisplayNode*>& resolved)
+{
+	/*
+	 * Only the nodes that were invalidated and the path leading to them are
+	 * visited. The root is always resolved because viewport changes are
+	 * tracked by the display and not by the nodes.
+	 */
+
+	const auto task = LayoutTask::getCurrent();
+
+	walker.visit(root,
+
+		[this, root, task, &resolved](DisplayNode* node) {
+
+			if (node != root &&
+				node->invalid == false &&
+				node->invalidDescendant == false) {
+				return false;
+			}
+
+			/*
+			 * A child out of the view of its virtualized parent stays invalid
+			 * until the layout brings it back in view.
+			 */
+
+			if (node != root &&
+				node->offscreen) {
+				return false;
+			}
+
+			/*
+			 * A node which callbacks cannot be called from another thread
+			 * is left invalid, the display reaches it once the task joined.
+			 */
+
+			if (task &&
+				node->isThreadSafe() == false) {
+				return false;
+			}
+
+			node->resolve();
+
+			resolved.push_back(node);
+
+			if (this->pool) {
+				this->resolveSubtrees(node);
+			}
+
+			return true;
+		},
+
+		[](DisplayNode* node) {
+
+			/*
+			 * A child can be invalidated after it has been visited, for
+			 * instance by a callback. Its path must remain marked so the
+			 * next pass reaches it.
+			 */
+
+			node->invalidDescendant = false;
+
+			for (auto child : node->children) {
+				if (child->visible && child->offscreen == false && (child->invalid || child->invalidDescendant)) {
+					node->invalidDescendant = true;
+					break;
+				}
+			}
+		}
+	);
+}
+
+void
+Display::resolveSubtrees(DisplayNode* node)
+{
+	/*
+	 * Once a node has been laid out, the size and origin of its children are
+	 * final and their subtrees no longer depend on each other. The invalid
+	 * subtrees which root accepts callbacks from any thread are resolved on
+	 * the pool, the other ones are left to the walker that called this.
+	 */
+
+	vector<DisplayNode*> roots;
+
+	for (auto child : node->children) {
+		if (child->visible && child->offscreen == false && child->isThreadSafe() && (child->invalid || child->invalidDescendant)) {
+			roots.push_back(child);
+		}
+	}
+
+	if (roots.size() < 2) {
+		return;
+	}
+
+	vector<LayoutTask*> tasks;
+
+	LayoutGroup group;
+
+	for (auto root : roots) {
+
+		auto task = new LayoutTask(root);
+
+		this->pool->submit(group, [this, task] {
+			task->run([this, task] {
+				this->resolveTree(task->root, task->walker, task->resolved);
+			});
+		});
+
+		tasks.push_back(task);
+	}
+
+	this->wait(group, tasks);
+
+	for (auto task : tasks) {
+		this->join(task);
+		delete task;
+	}
+}
+
+void
+Display::wait(LayoutGroup& group, vector<LayoutTask*>& tasks)
+{
+	/*
+	 * An exception thrown by a task, usually from a callback, is thrown
+	 * again on this thread once every task of the group has completed.
+	 * The results of the tasks are dropped along with them.
+	 */
+
+	try {
+
+		this->pool->wait(group);
+
+	} catch (...) {
+
+		for (auto task : tasks) {
+			delete task;
+		}
+
+		throw;
+	}
+}
+
+void
+Display::join(LayoutTask* task)
+{
+	/*
+	 * Tasks are joined in the order of their root within the parent, the
+	 * results are handed to the enclosing task if there is one so that the
+	 * callbacks are eventually replayed in the same order.
+	 */
+
+	auto parent = LayoutTask::getCurrent();
+
+	auto& resolved = parent ? parent->resolved : this->resolved;
+
+	resolved.insert(
+		resolved.end(),
+		task->resolved.begin(),
+		task->resolved.end()
+	);
+
+	auto& journal = parent ? parent->journal : this->journal;
+
+	journal.insert(
+		journal.end(),
+		task->journal.begin(),
+		task->journal.end()
+	);
+
+	if (parent) {
+		parent->measureCacheHits += task->measureCacheHits;
+		parent->measureCacheMisses += task->measureCacheMisses;
+		parent->styleCacheHits += task->styleCacheHits;
+		parent->styleCacheMisses += task->styleCacheMisses;
+	} else {
+		this->measureCacheHits += task->measureCacheHits;
+		this->measureCacheMisses += task->measureCacheMisses;
+		this->styleCacheHits += task->styleCacheHits;
+		this->styleCacheMisses += task->styleCacheMisses;
+	}
+
+	/*
+	 * The invalidations that had to reach beyond the task root are performed
+	 * now that nothing else runs within the parent.
+	 */
+
+	for (auto node : task->escaped) {
+		node->invalidateParent();
+	}
+
+	for (auto& event : task->events) {
+
+		if (parent) {
+			parent->events.push_back(event);
+			continue;
+		}
+
+		event.second(reinterpret_cast<DisplayNodeRef>(event.first));
+	}
+}
+
+void
+Display::schedule(DisplayNode* boundary)
+{
+	if (boundary->scheduled == false) {
+		boundary->scheduled = true;
+		this->boundaries.push_back(boundary);
+	}
+
+	this->invalidate();
+}
+
+void
+Display::unschedule(DisplayNode* boundary)
+{
+	auto it = find(
+		this->boundaries.begin(),
+		this->boundaries.end(),
+		boundary
+	);
+
+	if (it != this->boundaries.end()) {
+		this->boundaries.erase(it);
+	}
+
+	boundary->scheduled = false;
+}
+
+void
+Display::resolveBoundaries()
+{
+	/*
+	 * Boundaries scheduled while they are being resolved are processed on
+	 * the next pass, the same way invalidations raised by callbacks are.
+	 */
+
+	const auto count = this->boundaries.size();
+
+	for (size_t i = 0; i < count; i++) {
+
+		auto boundary = this->boundaries[i];
+
+		boundary->scheduled = false;
+
+		/*
+		 * An invalid boundary has marked the path from its parent, it is
+		 * resolved after its ancestors by one of the other walks.
+		 */
+
+		if (boundary->invalid ||
+			boundary->invalidDescendant == false) {
+			continue;
+		}
+
+		auto root = boundary;
+		auto offscreen = boundary->offscreen;
+
+		while (root->parent) {
+			root = root->parent;
+			offscreen = offscreen || root->offscreen;
+		}
+
+		if (root != this->window) {
+			continue;
+		}
+
+		/*
+		 * A boundary out of view is kept scheduled, nothing else leads the
+		 * walk to it once it comes back in view.
+		 */
+
+		if (offscreen) {
+			this->boundaries.push_back(boundary);
+			boundary->scheduled = true;
+			continue;
+		}
+
+		this->resolveTree(boundary, this->walker, this->resolved);
+
+		if (boundary->invalidDescendant) {
+			this->boundaries.push_back(boundary);
+			boundary->scheduled = true;
+		}
+	}
+
+	this->boundaries.erase(
+		this->boundaries.begin(),
+		this->boundaries.begin() + count
+	);
+}
+
+void
+Display::unjournal(DisplayNode* node)
+{
+	auto it = find(
+		this->journal.begin(),
+		this->journal.end(),
+		node
+	);
+
+	if (it != this->journal.end()) {
+		this->journal.erase(it);
+	}
+
+	node->changes = kDisplayNodeChangeNone;
+}
+
+void
+Display::clearJournal()
+{
+	for (auto node : this->journal) {
+		node->changes = kDisplayNodeChangeNone;
+	}
+
+	this->journal.clear();
+}
+
+void
+Display::unstyle(DisplayNode* node)
+{
+	/*
+	 * The node is deleted by a callback while the styles are applied, its
+	 * slot is cleared so the remaining nodes keep their order.
+	 */
+
+	auto it = find(
+		this->styled.begin(),
+		this->styled.end(),
+		node
+	);
+
+	if (it != this->styled.end()) {
+		*it = nullptr;
+	}
+
+	node->pendingTraits = false;
+}
+
+void
+Display::batchTraits(DisplayNode* node)
+{
+	this->traitBatch.push_back({
+		node,
+		node->styles,
+		node->states
+	});
+}
+
+void
+Display::unbatchTraits(DisplayNode* node)
+{
+	auto it = find_if(
+		this->traitBatch.begin(),
+		this->traitBatch.end(),
+		[node](const TraitSnapshot& snapshot) {
+			return snapshot.node == node;
+		}
+	);
+
+	if (it != this->traitBatch.end()) {
+		this->traitBatch.erase(it);
+	}
+
+	node->batchedTraits = false;
+}
+
 //------------------------------------------------------------------------------
 // MARK: Public API
 //------------------------------------------------------------------------------
@@ -72,20 +640,88 @@ Display::setStylesheet(Stylesheet* stylesheet)
 		 * presentation without reloading the application.
 		 */
 
-		DisplayNodeWalker walker(this->window);
+		this->walker.visit(this->window, [](DisplayNode* node) {
+			node->reset();
+			node->invalidateTraits();
+			return true;
+		});
+	}
 
-		while (walker.hasNext()) {
-			walker.getNode()->reset();
-			walker.getNode()->invalidateTraits();
-			walker.getNext();
-		}
+	if (stylesheet) {
+		stylesheet->retain();
+	}
+
+	if (this->stylesheet) {
+		this->stylesheet->release();
 	}
 
 	this->stylesheet = stylesheet;
 
+	/*
+	 * The style caches hold properties matched with the previous
+	 * stylesheet.
+	 */
+
+	this->traitsVersion++;
+
 	this->invalidate();
 }
 
+void
+Display::setLayoutThreads(size_t threads)
+{
+	if (this->resolving) {
+		throw InvalidOperationException("Cannot change the layout threads while the display is resolving.");
+	}
+
+	if (threads < 1) {
+		threads = 1;
+	}
+
+	if (this->getLayoutThreads() == threads) {
+		return;
+	}
+
+	delete this->pool;
+
+	this->pool = threads > 1 ? new LayoutPool(threads) : nullptr;
+}
+
+void
+Display::setNativeLayoutProperties(bool native)
+{
+	if (this->resolving) {
+		throw InvalidOperationException("Cannot change how layout properties are applied while the display is resolving.");
+	}
+
+	if (this->nativeLayoutProperties == native) {
+		return;
+	}
+
+	/*
+	 * The properties are reset the way they were applied, either by the
+	 * host or by the nodes, then applied again the other way.
+	 */
+
+	if (this->window) {
+		this->walker.visit(this->window, [](DisplayNode* node) {
+			node->reset();
+			node->invalidateTraits();
+			return true;
+		});
+	}
+
+	this->nativeLayoutProperties = native;
+
+	this->invalidate();
+}
+
+size_t
+Display::getLayoutThreads() const
+{
+	return this->pool ? this->pool->getThreadCount() : 1;
+}
+
 void
 Display::invalidate()
 {
@@ -109,19 +745,30 @@ Display::resolve()
 	
 	this->resolving = true;
 
+	this->clearJournal();
+
 	this->didPrepare();
 
-	DisplayNodeWalker walker(this->window);
+	this->resolveStyles();
 
-	while (walker.hasNext()) {
-		walker.getNode()->resolve();
-		walker.getNext();
-	}
+	this->resolveTree(this->window, this->walker, this->resolved);
+
+	this->resolveBoundaries();
+
+	this->didResolveEvents();
 
 	this->didResolve();
 
 	this->cleanup();
 
+	/*
+	 * The filter and the style cache refer to nodes styled during this
+	 * pass, they can be moved or deleted before the next one.
+	 */
+
+	this->filter.clear();
+	this->styleCache.clear();
+
 	this->resolving = false;
 
 	this->viewportWidthChanged = false;
@@ -130,15 +777,144 @@ Display::resolve()
 	this->invalid = false;
 }
 
+size_t
+Display::getChangedFrames(DisplayNodeFrame* buffer, size_t capacity) const
+{
+	/*
+	 * The frames are copied in the order the nodes changed. The count of
+	 * changed nodes is returned even if the buffer is too small, which can
+	 * be used to size it before reading the frames. Nodes that were only
+	 * laid out have no frame.
+	 */
+
+	size_t count = 0;
+
+	for (auto node : this->journal) {
+
+		if ((node->changes & ~kDisplayNodeChangeLayout) == 0) {
+			continue;
+		}
+
+		if (buffer == nullptr ||
+			count >= capacity) {
+			count++;
+			continue;
+		}
+
+		auto& frame = buffer[count++];
+
+		frame.node = reinterpret_cast<DisplayNodeRef>(node);
+		frame.top = node->measuredTop;
+		frame.left = node->measuredLeft;
+		frame.width = node->measuredWidth;
+		frame.height = node->measuredHeight;
+		frame.innerWidth = node->measuredInnerWidth;
+		frame.innerHeight = node->measuredInnerHeight;
+		frame.contentWidth = node->measuredContentWidth;
+		frame.contentHeight = node->measuredContentHeight;
+		frame.marginTop = node->measuredMarginTop;
+		frame.marginLeft = node->measuredMarginLeft;
+		frame.marginRight = node->measuredMarginRight;
+		frame.marginBottom = node->measuredMarginBottom;
+		frame.borderTop = node->measuredBorderTop;
+		frame.borderLeft = node->measuredBorderLeft;
+		frame.borderRight = node->measuredBorderRight;
+		frame.borderBottom = node->measuredBorderBottom;
+		frame.paddingTop = node->measuredPaddingTop;
+		frame.paddingLeft = node->measuredPaddingLeft;
+		frame.paddingRight = node->measuredPaddingRight;
+		frame.paddingBottom = node->measuredPaddingBottom;
+		frame.changes = node->changes & ~kDisplayNodeChangeLayout;
+	}
+
+	return count;
+}
+
+void
+Display::didResolveEvents()
+{
+	/*
+	 * The journal already holds every node once with the changes it went
+	 * through, the events are delivered from it in a single call instead
+	 * of a callback per node and per change.
+	 */
+
+	if (this->eventsCallback == nullptr) {
+		return;
+	}
+
+	this->events.clear();
+
+	for (auto node : this->journal) {
+		this->events.push_back({
+			reinterpret_cast<DisplayNodeRef>(node),
+			node->changes
+		});
+	}
+
+	if (this->events.size()) {
+		this->eventsCallback(
+			reinterpret_cast<DisplayRef>(this),
+			this->events.data(),
+			this->events.size()
+		);
+	}
+}
+
+void
+Display::beginTraitBatch()
+{
+	if (LayoutTask::getCurrent()) {
+		throw InvalidOperationException("Cannot batch traits from a layout thread.");
+	}
+
+	this->traitBatchDepth++;
+}
+
+void
+Display::endTraitBatch()
+{
+	if (LayoutTask::getCurrent()) {
+		throw InvalidOperationException("Cannot batch traits from a layout thread.");
+	}
+
+	if (this->traitBatchDepth == 0 ||
+		this->traitBatchDepth-- > 1) {
+		return;
+	}
+
+	/*
+	 * Each node changed during the batch is compared with the styles and
+	 * states it had before its first change and is invalidated once, a
+	 * state added then removed does not invalidate anything.
+	 */
+
+	for (auto& snapshot : this->traitBatch) {
+		snapshot.node->batchedTraits = false;
+		snapshot.node->invalidateChangedTraits(snapshot.styles, snapshot.states);
+	}
+
+	this->traitBatch.clear();
+}
+
 void
 Display::cleanup()
 {
-	DisplayNodeWalker wakler(this->window);
+	/*
+	 * The changed flags are only set on the nodes that were resolved and on
+	 * the children they laid out, there is no need to walk the whole tree.
+	 */
 
-	while (wakler.hasNext()) {
-		wakler.getNode()->cleanup();
-		wakler.getNext();
+	for (auto node : this->resolved) {
+
+		node->cleanup();
+
+		for (auto child : node->children) {
+			child->cleanup();
+		}
 	}
+
+	this->resolved.clear();
 }
 
 }
@@ -2,17 +2,25 @@
 #define Display_h
 
 #include "DisplayBase.h"
+#include "DisplayNodeWalker.h"
+#include "DisplayNodeStyleCache.h"
 #include "Stylesheet.h"
+#include "AncestorFilter.h"
 
+#include <atomic>
 #include <string>
-#include <queue>
+#include <vector>
 
+using std::atomic;
 using std::string;
-using std::queue;
+using std::vector;
 
 namespace Dezel {
 
 namespace Layout {
+	class LayoutPool;
+	class LayoutGroup;
+	class LayoutTask;
 	class LayoutResolver;
 	class AbsoluteLayoutResolver;
 	class RelativeLayoutResolver;
@@ -23,20 +31,50 @@ namespace Style {
 	class Stylesheet;
 }
 
+using Layout::LayoutPool;
+using Layout::LayoutGroup;
+using Layout::LayoutTask;
 using Layout::LayoutResolver;
 using Layout::AbsoluteLayoutResolver;
 using Layout::RelativeLayoutResolver;
 using Style::StyleResolver;
 using Style::Stylesheet;
+using Style::AncestorFilter;
 
 class DisplayNode;
-class DisplayNodeFrame;
 
 class Display {
 
 private:
 
-	queue<DisplayNode*> walker;
+	DisplayNodeWalker walker;
+	DisplayNodeWalker traitsWalker;
+
+	AncestorFilter filter;
+
+	DisplayNodeStyleCache styleCache;
+
+	atomic<unsigned> traitsVersion{0};
+
+	Style::PropertyDiff propertyDiff;
+
+	vector<DisplayNode*> styled;
+	vector<DisplayNode*> resolved;
+	vector<DisplayNode*> boundaries;
+	vector<DisplayNode*> journal;
+	vector<DisplayNodeEvent> events;
+
+	struct TraitSnapshot {
+		DisplayNode* node;
+		vector<Atom> styles;
+		vector<Atom> states;
+	};
+
+	vector<TraitSnapshot> traitBatch;
+
+	size_t traitBatchDepth = 0;
+
+	LayoutPool* pool = nullptr;
 
 	DisplayNode* window = nullptr;
 
@@ -49,13 +87,39 @@ private:
 
 	Stylesheet* stylesheet = nullptr;
 
+	bool nativeLayoutProperties = false;
+
 	bool invalid = false;
 	bool updated = false;
 	bool resolving = false;
 
+	size_t measureCacheHits = 0;
+	size_t measureCacheMisses = 0;
+	size_t styleCacheHits = 0;
+	size_t styleCacheMisses = 0;
+
 	DisplayCallback invalidateCallback = nullptr;
 	DisplayCallback prepareCallback = nullptr;
    	DisplayCallback resolveCallback = nullptr;
+	DisplayEventsCallback eventsCallback = nullptr;
+
+	void resolveStyles();
+	void resolveTree(DisplayNode* root, DisplayNodeWalker& walker, vector<DisplayNode*>& resolved);
+	void resolveSubtrees(DisplayNode* node);
+	void wait(LayoutGroup& group, vector<LayoutTask*>& tasks);
+	void join(LayoutTask* task);
+
+	void schedule(DisplayNode* boundary);
+	void unschedule(DisplayNode* boundary);
+	void resolveBoundaries();
+
+	void unjournal(DisplayNode* node);
+	void clearJournal();
+
+	void unstyle(DisplayNode* node);
+
+	void batchTraits(DisplayNode* node);
+	void unbatchTraits(DisplayNode* node);
 
 	void didPrepare() {
 		if (this->prepareCallback) {
@@ -63,6 +127,8 @@ private:
 		}
 	}
 
+	void didResolveEvents();
+
 	void didResolve() {
 		if (this->resolveCallback) {
 			this->resolveCallback(reinterpret_cast<DisplayRef>(this));
@@ -78,6 +144,8 @@ public:
 
 	void *data = nullptr;
 
+	~Display();
+
 	void setWindow(DisplayNode* window);
 
 	void setScale(double scale);
@@ -85,6 +153,8 @@ public:
 	void setViewportHeight(double viewportHeight);
 
 	void setStylesheet(Stylesheet* stylesheet);
+	void setLayoutThreads(size_t threads);
+	void setNativeLayoutProperties(bool native);
 
 	void setPrepareCallback(DisplayCallback callback) {
 		this->prepareCallback = callback;
@@ -94,6 +164,10 @@ public:
 		this->resolveCallback = callback;
 	}
 
+	void setEventsCallback(DisplayEventsCallback callback) {
+		this->eventsCallback = callback;
+	}
+
 	double getScale() const {
 		return this->scale;
 	}
@@ -110,6 +184,12 @@ public:
 		return this->stylesheet;
 	}
 
+	size_t getLayoutThreads() const;
+
+	bool hasNativeLayoutProperties() const {
+		return this->nativeLayoutProperties;
+	}
+
 	bool hasNewViewportWidth() const {
 		return this->viewportWidthChanged;
 	}
@@ -118,6 +198,24 @@ public:
 		return this->viewportHeightChanged;
 	}
 
+	size_t getMeasureCacheHits() const {
+		return this->measureCacheHits;
+	}
+
+	size_t getMeasureCacheMisses() const {
+		return this->measureCacheMisses;
+	}
+
+	size_t getStyleCacheHits() const {
+		return this->styleCacheHits;
+	}
+
+	size_t getStyleCacheMisses() const {
+		return this->styleCacheMisses;
+	}
+
+	size_t getChangedFrames(DisplayNodeFrame* buffer, size_t capacity) const;
+
 	bool isInvalid() const {
 		return this->invalid;
 	}
@@ -126,6 +224,17 @@ public:
 		return this->resolving;
 	}
 
+	bool isBatchingEvents() const {
+		return this->eventsCallback && this->resolving;
+	}
+
+	bool isBatchingTraits() const {
+		return this->traitBatchDepth > 0;
+	}
+
+	void beginTraitBatch();
+	void endTraitBatch();
+
 	void invalidate();
 	void resolve();
 	void cleanup();
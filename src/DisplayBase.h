@@ -212,6 +212,16 @@ typedef enum {
 	kContentDirectionHorizontal = 2
 } ContentDirection;
 
+/**
+ * @type ContentWrap
+ * @since 0.1.0
+ * @hidden
+ */
+typedef enum {
+	kContentWrapNone = 1,
+	kContentWrapLines = 2
+} ContentWrap;
+
 /**
  * @type ContentAlignment
  * @since 0.1.0
@@ -322,6 +332,63 @@ typedef struct {
 	double height;
 } MeasuredSize;
 
+/**
+ * @typedef DisplayNodeChange
+ * @since 0.1.0
+ * @hidden
+ */
+typedef enum {
+	kDisplayNodeChangeNone = 0,
+	kDisplayNodeChangeSize = 1 << 0,
+	kDisplayNodeChangeOrigin = 1 << 1,
+	kDisplayNodeChangeInnerSize = 1 << 2,
+	kDisplayNodeChangeContentSize = 1 << 3,
+	kDisplayNodeChangeMargins = 1 << 4,
+	kDisplayNodeChangeBorders = 1 << 5,
+	kDisplayNodeChangePadding = 1 << 6,
+	kDisplayNodeChangeLayout = 1 << 7
+} DisplayNodeChange;
+
+/**
+ * @typedef DisplayNodeEvent
+ * @since 0.1.0
+ * @hidden
+ */
+typedef struct {
+	DisplayNodeRef node;
+	unsigned int changes;
+} DisplayNodeEvent;
+
+/**
+ * @typedef DisplayNodeFrame
+ * @since 0.1.0
+ * @hidden
+ */
+typedef struct {
+	DisplayNodeRef node;
+	double top;
+	double left;
+	double width;
+	double height;
+	double innerWidth;
+	double innerHeight;
+	double contentWidth;
+	double contentHeight;
+	double marginTop;
+	double marginLeft;
+	double marginRight;
+	double marginBottom;
+	double borderTop;
+	double borderLeft;
+	double borderRight;
+	double borderBottom;
+	double paddingTop;
+	double paddingLeft;
+	double paddingRight;
+	double paddingBottom;
+	unsigned int changes;
+} DisplayNodeFrame;
+
 /**
  * @typedef ValueType
  * @since 0.1.0
@@ -362,6 +429,13 @@ typedef enum  {
  */
 typedef void (*DisplayCallback)(DisplayRef display);
 
+/**
+ * @typedef DisplayEventsCallback
+ * @since 0.1.0
+ * @hidden
+ */
+typedef void (*DisplayEventsCallback)(DisplayRef display, const DisplayNodeEvent* events, size_t count);
+
 /**
  * @typedef DisplayNodeMeasureCallback
  * @since 0.1.0
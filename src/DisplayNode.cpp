@@ -3,6 +3,7 @@
 #include "DisplayNode.h"
 #include "DisplayNodeWalker.h"
 #include "LayoutResolver.h"
+#include "LayoutTask.h"
 #include "Descriptor.h"
 #include "PropertyList.h"
 #include "Selector.h"
@@ -10,6 +11,8 @@
 #include "Matcher.h"
 #include "Matches.h"
 #include "Match.h"
+#include "InvalidationSet.h"
+#include "DisplayNodeLayoutProperties.h"
 #include "InvalidStructureException.h"
 #include "InvalidOperationException.h"
 
@@ -28,17 +31,73 @@ using std::stringstream;
 using Layout::clamp;
 using Layout::round;
 using Layout::scale;
+using Layout::LayoutTask;
 
 using Style::PropertyList;
+using Style::PropertyDiff;
 using Style::Matcher;
 using Style::Matches;
 
-DisplayNode::DisplayNode() : layout(this)
-{
-
-}
-
-DisplayNode::DisplayNode(Display* display) : layout(this)
+/*
+ * Most of a node is made of its box specs, its measured values, its
+ * callbacks and its layout resolver, none of which can shrink without
+ * changing the api. Everything else, the flags, the tree links, the traits
+ * and the properties, must fit within four cache lines. Optional state such
+ * as the measure cache is kept behind a pointer instead.
+ */
+
+static_assert(
+	sizeof(DisplayNode) <=
+		sizeof(DisplayNodeSize) * 2 +
+		sizeof(DisplayNodeOrigin) * 4 +
+		sizeof(DisplayNodeAnchor) * 2 +
+		sizeof(DisplayNodeContentOrigin) * 2 +
+		sizeof(DisplayNodeContentSize) * 2 +
+		sizeof(DisplayNodeBorder) * 4 +
+		sizeof(DisplayNodeMargin) * 4 +
+		sizeof(DisplayNodePadding) * 4 +
+		sizeof(double) * 28 +
+		sizeof(DisplayNodeCallback) * 12 +
+		sizeof(LayoutResolver) +
+		64 * 4,
+	"The display node exceeds its memory budget."
+);
+
+DisplayNode::DisplayNode() :
+	invalid(false),
+	invalidDescendant(false),
+	invalidSize(false),
+	invalidOrigin(false),
+	invalidMargin(false),
+	invalidBorder(false),
+	invalidInnerSize(false),
+	invalidContentSize(false),
+	invalidContentOrigin(false),
+	invalidPadding(false),
+	invalidExtent(false),
+	invalidLayout(false),
+	invalidTraits(false),
+	scheduled(false),
+	resolving(false),
+	resolvedSize(false),
+	resolvedOrigin(false),
+	inheritedWrappedContentWidth(false),
+	inheritedWrappedContentHeight(false),
+	measuredWidthChanged(false),
+	measuredHeightChanged(false),
+	measuredInnerWidthChanged(false),
+	measuredInnerHeightChanged(false),
+	measuredContentWidthChanged(false),
+	measuredContentHeightChanged(false),
+	offscreen(false),
+	batchedTraits(false),
+	pendingTraits(false),
+	layout(this)
+{
+
+}
+
+DisplayNode::DisplayNode(Display* display) : DisplayNode()
 {
 	this->display = display;
 }
@@ -48,10 +107,73 @@ DisplayNode::DisplayNode(Display* display, string type) : DisplayNode(display)
 	this->setType(type);
 }
 
+DisplayNode::~DisplayNode()
+{
+	this->detach();
+
+	if (this->pendingProperties) {
+		this->pendingProperties->release();
+	}
+
+	if (this->properties) {
+		this->properties->release();
+	}
+
+	if (this->stylesheet) {
+		this->stylesheet->release();
+	}
+
+	delete this->measureCache;
+	delete this->virtualization;
+}
+
 //------------------------------------------------------------------------------
 // MARK: Private API
 //------------------------------------------------------------------------------
 
+void
+DisplayNode::detach()
+{
+	/*
+	 * Removes the node from the lists its display keeps, the display is
+	 * null once it has been deleted.
+	 */
+
+	if (this->display == nullptr) {
+		return;
+	}
+
+	if (this->scheduled) {
+		this->display->unschedule(this);
+	}
+
+	if (this->changes) {
+		this->display->unjournal(this);
+	}
+
+	if (this->batchedTraits) {
+		this->display->unbatchTraits(this);
+	}
+
+	if (this->pendingTraits) {
+		this->display->unstyle(this);
+	}
+}
+
+void
+DisplayNode::touchTraits()
+{
+	/*
+	 * The ancestor filters and the style caches of the display read the
+	 * traits and the ancestors of their nodes once, they are rebuilt after
+	 * any change.
+	 */
+
+	if (this->display) {
+		this->display->traitsVersion++;
+	}
+}
+
 void
 DisplayNode::explode(string type)
 {
@@ -59,7 +181,7 @@ DisplayNode::explode(string type)
 	stringstream stream(type);
 
 	while (getline(stream, token, ' ')) {
-		this->types.push_back(token);
+		this->types.push_back(Atoms::intern(token));
 	}
 }
 
@@ -426,8 +548,32 @@ DisplayNode::invalidate()
 	}
 
 	if (this->invalid == false) {
+
 		this->invalid = true;
-		this->display->invalidate();
+
+		/*
+		 * A node resolved concurrently does not touch anything above the
+		 * subtree of its task. The display recomputes the path of the task
+		 * root once it completes and is already being resolved.
+		 */
+
+		auto task = LayoutTask::getCurrent();
+
+		if (task == nullptr) {
+
+			if (this->parent) {
+				this->parent->invalidateDescendant();
+			}
+
+			this->display->invalidate();
+
+		} else if (task->root != this) {
+
+			if (this->parent) {
+				this->parent->invalidateDescendant();
+			}
+		}
+
 		this->didInvalidate();
 	}
 }
@@ -530,9 +676,32 @@ DisplayNode::invalidateLayout()
 	}
 }
 
+void
+DisplayNode::invalidateMeasure()
+{
+	/*
+	 * The measures are cached by constraints and only go stale when the
+	 * host changes the content of the node, which it has to tell.
+	 */
+
+	if (this->measureCache) {
+		this->measureCache->clear();
+	}
+
+	this->invalidateSize();
+}
+
 void
 DisplayNode::invalidateParent()
 {
+	auto task = LayoutTask::getCurrent();
+
+	if (task &&
+		task->root == this) {
+		task->escaped.push_back(this);
+		return;
+	}
+
 	auto parent = this->parent;
 
 	if (parent == nullptr ||
@@ -543,10 +712,14 @@ DisplayNode::invalidateParent()
 	parent->invalidateExtent();
 	parent->invalidateLayout();
 
+	if (parent->isLayoutBoundary()) {
+		return;
+	}
+
 	/*
 	 * This view might be within a wrapped view which itself can be inside another
 	 * wrapper view. We need to find the highest parent of a wrap chain and invalidate
-	 * this one.
+	 * this one. The chain ends at the first layout boundary.
 	 */
 
 	const auto parentW = parent->width;
@@ -564,12 +737,22 @@ DisplayNode::invalidateParent()
 
 		while (node != nullptr) {
 
+			if (task &&
+				task->root == node) {
+				task->escaped.push_back(node);
+				break;
+			}
+
 			node = node->parent;
 
 			if (node) {
 
-				const auto w = width;
-				const auto h = height;
+				if (node->isLayoutBoundary()) {
+					break;
+				}
+
+				const auto w = node->width;
+				const auto h = node->height;
 
 				if (w.type != kSizeTypeWrap && h.type != kSizeTypeWrap &&
 					w.type != kSizeTypeFill && h.type != kSizeTypeFill) {
@@ -589,15 +772,67 @@ DisplayNode::invalidateParent()
 		}
 
 		if (last &&
-			last->parent) {
+			last->parent &&
+			last != (task ? task->root : nullptr)) {
 			last->parent->invalidateLayout();
 		}
 	}
 }
 
+void
+DisplayNode::invalidateDescendant()
+{
+	/*
+	 * Marks the path from this node to the window so the display only
+	 * visits the branches that leads to invalid nodes. The walk stops at
+	 * the first node already marked since its ancestors are marked as well.
+	 */
+
+	auto task = LayoutTask::getCurrent();
+	auto root = task ? task->root : nullptr;
+
+	auto node = this;
+
+	while (node && node->invalidDescendant == false) {
+
+		node->invalidDescendant = true;
+
+		if (node == root) {
+			break;
+		}
+
+		/*
+		 * Changes below a layout boundary reach its ancestors through
+		 * invalidateParent only. Instead of marking the path up to the
+		 * window the boundary is given to the display which resolves it
+		 * directly.
+		 */
+
+		if (task == nullptr &&
+			node->display &&
+			node->parent &&
+			node->isLayoutBoundary()) {
+			node->display->schedule(node);
+			break;
+		}
+
+		node = node->parent;
+	}
+}
+
 void
 DisplayNode::invalidateTraits()
 {
+	/*
+	 * The properties matched ahead of the layout no longer apply once the
+	 * traits of the node or of its ancestors change.
+	 */
+
+	if (this->pendingProperties) {
+		this->pendingProperties->release();
+		this->pendingProperties = nullptr;
+	}
+
 	if (this->invalidTraits == false) {
 		this->invalidTraits = true;
 		this->invalidate();
@@ -605,21 +840,285 @@ DisplayNode::invalidateTraits()
 }
 
 void
-DisplayNode::invalidateStyleTraits()
+DisplayNode::invalidateStyleTraits(Atom style)
 {
-	if (this->invalidStyleTraits == false) {
-		this->invalidStyleTraits = true;
-		this->invalidateTraits();
+	this->invalidateTraits();
+
+	if (this->display == nullptr ||
+		this->display->stylesheet == nullptr) {
+		return;
+	}
+
+	auto invalidations = this->display->stylesheet->getStyleInvalidationSet(style);
+
+	if (invalidations) {
+		this->invalidateDescendantTraits({invalidations});
 	}
 }
 
 void
-DisplayNode::invalidateStateTraits()
+DisplayNode::invalidateStateTraits(Atom state)
 {
-	if (this->invalidStateTraits == false) {
-		this->invalidStateTraits = true;
-		this->invalidateTraits();
+	this->invalidateTraits();
+
+	if (this->display == nullptr ||
+		this->display->stylesheet == nullptr) {
+		return;
+	}
+
+	auto invalidations = this->display->stylesheet->getStateInvalidationSet(state);
+
+	if (invalidations) {
+		this->invalidateDescendantTraits({invalidations});
+	}
+}
+
+void
+DisplayNode::invalidateChangedTraits(const vector<Atom>& styles, const vector<Atom>& states)
+{
+	/*
+	 * Compares the given styles and states with the current ones and
+	 * invalidates the node once, along with the descendants affected by any
+	 * of the styles or states that were added or removed.
+	 */
+
+	auto stylesheet = this->display ? this->display->stylesheet : nullptr;
+
+	vector<const InvalidationSet*> invalidations;
+
+	bool changed = false;
+
+	auto compare = [&](const vector<Atom>& a, const vector<Atom>& b, bool style) {
+		for (auto atom : a) {
+
+			if (find(b.begin(), b.end(), atom) != b.end()) {
+				continue;
+			}
+
+			changed = true;
+
+			if (stylesheet == nullptr) {
+				continue;
+			}
+
+			auto set = style ? stylesheet->getStyleInvalidationSet(atom) : stylesheet->getStateInvalidationSet(atom);
+
+			if (set && find(invalidations.begin(), invalidations.end(), set) == invalidations.end()) {
+				invalidations.push_back(set);
+			}
+		}
+	};
+
+	compare(styles, this->styles, true);
+	compare(this->styles, styles, true);
+	compare(states, this->states, false);
+	compare(this->states, states, false);
+
+	if (changed == false) {
+		return;
+	}
+
+	this->invalidateTraits();
+
+	if (invalidations.size()) {
+		this->invalidateDescendantTraits(invalidations);
+	}
+}
+
+void
+DisplayNode::invalidateDescendantTraits(const vector<const InvalidationSet*>& invalidations)
+{
+	/*
+	 * Only called when the stylesheet has a rule that uses one of the
+	 * changed styles or states on a parent fragment, the other descendants
+	 * cannot be affected.
+	 */
+
+	auto task = LayoutTask::getCurrent();
+
+	auto& walker = task ? task->traitsWalker : this->display->traitsWalker;
+
+	walker.visit(this, [&](DisplayNode* node) {
+
+		if (node == this) {
+			return true;
+		}
+
+		for (auto set : invalidations) {
+			if (set->match(node)) {
+				node->invalidateTraits();
+				break;
+			}
+		}
+
+		return true;
+	});
+}
+
+bool
+DisplayNode::batchTraits()
+{
+	/*
+	 * Records the styles and states of the node the first time they change
+	 * during a batch, the node is invalidated once the batch ends based on
+	 * what actually changed. The batch belongs to the main thread, a node
+	 * changed from a layout thread is invalidated right away instead.
+	 */
+
+	if (this->display == nullptr ||
+		this->display->isBatchingTraits() == false) {
+		return false;
+	}
+
+	if (LayoutTask::getCurrent()) {
+		return false;
+	}
+
+	if (this->batchedTraits == false) {
+		this->batchedTraits = true;
+		this->display->batchTraits(this);
+	}
+
+	return true;
+}
+
+void
+DisplayNode::measure(MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh)
+{
+	if (this->measureCallback == nullptr) {
+		return;
+	}
+
+	/*
+	 * Measuring usually means shaping text or decoding an image on the
+	 * host side. The same constraints are often given more than once per
+	 * resolve so the most recent results are kept until the node explicitly
+	 * invalidates its measure.
+	 */
+
+	if (this->measureCache == nullptr) {
+		this->measureCache = new DisplayNodeMeasureCache();
+	}
+
+	auto task = LayoutTask::getCurrent();
+
+	if (this->measureCache->find(size, w, h, minw, maxw, minh, maxh)) {
+
+		if (task) {
+			task->measureCacheHits++;
+		} else {
+			this->display->measureCacheHits++;
+		}
+
+		return;
+	}
+
+	if (task) {
+		task->measureCacheMisses++;
+	} else {
+		this->display->measureCacheMisses++;
+	}
+
+	this->measureCallback(reinterpret_cast<DisplayNodeRef>(this), size, w, h, minw, maxw, minh, maxh);
+
+	this->measureCache->store(size, w, h, minw, maxw, minh, maxh);
+}
+
+void
+DisplayNode::notify(DisplayNodeCallback callback)
+{
+	/*
+	 * Notifications raised while a subtree is resolved concurrently are
+	 * queued and replayed by the display once the task has joined, this way
+	 * they are received in the same order regardless of scheduling. Only
+	 * the callbacks the layout waits for, measure, prepare layout and
+	 * update, are invoked from the task.
+	 */
+
+	auto task = LayoutTask::getCurrent();
+
+	if (task) {
+		task->events.push_back({this, callback});
+		return;
+	}
+
+	callback(reinterpret_cast<DisplayNodeRef>(this));
+}
+
+void
+DisplayNode::dispatch(DisplayNodeCallback callback)
+{
+	/*
+	 * When the display batches events the changes are only delivered from
+	 * the journal.
+	 */
+
+	if (this->display->isBatchingEvents()) {
+		return;
+	}
+
+	this->notify(callback);
+}
+
+void
+DisplayNode::journal(DisplayNodeChange change)
+{
+	/*
+	 * The node is added to the journal the first time one of its measures
+	 * changes, the host reads the frames of the journaled nodes at once
+	 * instead of querying every node after a resolve. Layouts are not
+	 * measures and are only journaled to be delivered as batched events.
+	 */
+
+	if (change == kDisplayNodeChangeLayout &&
+		this->display->isBatchingEvents() == false) {
+		return;
+	}
+
+	if (this->changes == kDisplayNodeChangeNone) {
+
+		auto task = LayoutTask::getCurrent();
+
+		if (task) {
+			task->journal.push_back(this);
+		} else {
+			this->display->journal.push_back(this);
+		}
+	}
+
+	this->changes |= change;
+}
+
+bool
+DisplayNode::isLayoutBoundary()
+{
+	if (this->flags & (kDisplayNodeFlagWindow | kDisplayNodeFlagLayoutBoundary)) {
+		return true;
+	}
+
+	/*
+	 * A node which size does not depend on its content is a boundary as
+	 * well. Filling nodes only qualify when they are not within a wrapped
+	 * parent, in which case they grow with their content.
+	 */
+
+	const auto w = this->width.type;
+	const auto h = this->height.type;
+
+	if (w == kSizeTypeWrap ||
+		h == kSizeTypeWrap) {
+		return false;
+	}
+
+	if (w == kSizeTypeFill && this->inheritsWrappedWidth()) {
+		return false;
+	}
+
+	if (h == kSizeTypeFill && this->inheritsWrappedHeight()) {
+		return false;
 	}
+
+	return true;
 }
 
 bool
@@ -706,6 +1205,109 @@ DisplayNode::inheritsWrappedHeight()
 	return false;
 }
 
+const PropertyList*
+DisplayNode::matchTraits()
+{
+	auto task = LayoutTask::getCurrent();
+
+	auto& cache = task ? task->styleCache : this->display->styleCache;
+	auto& filter = task ? task->filter : this->display->filter;
+
+	const auto version = this->display->traitsVersion.load();
+
+	cache.sync(version);
+
+	/*
+	 * Siblings such as the rows of a list usually have the same traits,
+	 * the properties of the first one are shared with the other ones.
+	 */
+
+	auto shared = cache.find(this);
+
+	if (shared) {
+
+		if (task) {
+			task->styleCacheHits++;
+		} else {
+			this->display->styleCacheHits++;
+		}
+
+		shared->retain();
+
+		return shared;
+	}
+
+	if (task) {
+		task->styleCacheMisses++;
+	} else {
+		this->display->styleCacheMisses++;
+	}
+
+	filter.sync(this->parent, version);
+
+	Matches matches;
+	Matcher matcher;
+
+	matcher.match(this, matches, this->display->stylesheet, filter);
+	matches.order();
+
+	auto properties = this->display->stylesheet->getMatchedProperties(matches);
+
+	/*
+	 * A node without a parent never shares its properties and could be
+	 * deleted without being removed from a tree first.
+	 */
+
+	if (this->parent) {
+		cache.store(this);
+	}
+
+	return properties;
+}
+
+bool
+DisplayNode::applyProperty(const Property* previous, Property* property)
+{
+	/*
+	 * Layout properties are given to the node setters directly when the
+	 * display handles them, the others are given to the host. Returns
+	 * whether the host was given the property.
+	 */
+
+	auto native = this->display && this->display->nativeLayoutProperties;
+
+	auto replaced = native && previous && DisplayNodeLayoutProperties::accepts(previous);
+	auto accepted = native && property && DisplayNodeLayoutProperties::accepts(property);
+
+	if (accepted) {
+
+		DisplayNodeLayoutProperties::apply(this, property);
+
+		if (previous && replaced == false) {
+			this->updateProperty(previous->getName(), nullptr);
+			return true;
+		}
+
+		return false;
+	}
+
+	if (replaced) {
+
+		DisplayNodeLayoutProperties::reset(this, previous);
+
+		if (property == nullptr) {
+			return false;
+		}
+	}
+
+	this->updateProperty(
+		property ? property->getName() : previous->getName(),
+		property
+	);
+
+	return true;
+}
+
 void
 DisplayNode::resolveTraits()
 {
@@ -716,61 +1318,85 @@ DisplayNode::resolveTraits()
 	if (this->invalidTraits == false) {
 		return;
 	}
-	
-	Matches matches;
-	Matcher matcher;
 
-	matcher.match(this, matches, this->display->stylesheet->getRuleDescriptors());
-	matches.order();
+	auto properties = this->pendingProperties;
+
+	if (properties == nullptr) {
+		properties = this->matchTraits();
+	}
 
-	PropertyList properties;
+	this->pendingProperties = nullptr;
 
-	for (auto match : matches) {
-		properties.merge(match.getDescriptor()->getProperties());
+	if (properties == this->properties) {
+		properties->release();
+		this->invalidTraits = false;
+		return;
 	}
 
-	vector<Property*> insert;
-	vector<Property*> update;
-	vector<Property*> remove;
+	static const PropertyList none;
 
-	insert.reserve(max(this->properties.size(), properties.size()));
-	update.reserve(max(this->properties.size(), properties.size()));
-	remove.reserve(max(this->properties.size(), properties.size()));
+	auto& previous = this->properties ? *this->properties : none;
 
-	this->properties.diffs(
-		properties,
-		insert,
-		update,
-		remove
-	);
+	/*
+	 * The previous properties and their stylesheet are released once they
+	 * have been replaced, the stylesheet may have been deleted by the host
+	 * since they were matched.
+	 */
 
-	for (auto property : remove) this->updateProperty(property->getName(), nullptr);
-	for (auto property : update) this->updateProperty(property->getName(), property);
-	for (auto property : insert) this->updateProperty(property->getName(), property);
+	auto replaced = this->properties;
+	auto stylesheet = this->stylesheet;
+
+	auto task = LayoutTask::getCurrent();
+
+	auto& scratch = task ? task->propertyDiff : this->display->propertyDiff;
+
+	/*
+	 * The scratch buffer is still being read when the host resolves the
+	 * traits of another node from its update callback.
+	 */
+
+	PropertyDiff nested;
+
+	auto& diff = scratch.busy ? nested : scratch;
+
+	diff.busy = true;
+
+	previous.diffs(*properties, diff);
 
 	this->properties = properties;
 
-	if (this->invalidStyleTraits ||
-		this->invalidStateTraits) {
+	this->stylesheet = this->display->stylesheet;
+	this->stylesheet->retain();
+
+	auto updated = false;
+
+	for (auto property : diff.removes) updated |= this->applyProperty(property, nullptr);
+	for (auto property : diff.updates) updated |= this->applyProperty(previous.find(property->getId()), property);
+	for (auto property : diff.inserts) updated |= this->applyProperty(nullptr, property);
+
+	if (this->measureCache) {
 
 		/*
-		 * TODO
-		 * There is an optimization to be done here. First, there's no need
-		 * to invalidate the tree if none of the matched styles have child
-		 * descriptors..
+		 * Properties such as the font size are applied by the host and are
+		 * likely to change the intrinsic size of the node.
 		 */
 
-		DisplayNodeWalker walker(this);
-
-		while (walker.hasNext()) {
-			walker.getNode()->invalidateTraits();
-			walker.getNext();
+		if (updated) {
+			this->measureCache->clear();
 		}
 	}
 
+	diff.busy = false;
+
+	if (replaced) {
+		replaced->release();
+	}
+
+	if (stylesheet) {
+		stylesheet->release();
+	}
+
 	this->invalidTraits = false;
-	this->invalidStyleTraits = false;
-	this->invalidStateTraits = false;
 }
 
 void
@@ -1739,11 +2365,23 @@ DisplayNode::measureContentHeight()
 // MARK: Public API
 //------------------------------------------------------------------------------
 
+void
+DisplayNode::setDisplay(Display* display)
+{
+	if (this->display != display) {
+		this->detach();
+		this->display = display;
+	}
+}
+
 void
 DisplayNode::setName(string name)
 {
-	if (this->name != name) {
-		this->name = name;
+	auto atom = Atoms::intern(name);
+
+	if (this->name != atom) {
+		this->name = atom;
+		this->touchTraits();
 		this->invalidateTraits();
 	}
 }
@@ -1751,9 +2389,12 @@ DisplayNode::setName(string name)
 void
 DisplayNode::setType(string type)
 {
-	if (this->type != type) {
-		this->type = type;
+	auto atom = Atoms::intern(type);
+
+	if (this->type != atom) {
+		this->type = atom;
 		this->explode(type);
+		this->touchTraits();
 		this->invalidateTraits();
 	}
 
@@ -1762,73 +2403,169 @@ DisplayNode::setType(string type)
 void
 DisplayNode::appendStyle(string style)
 {
+	auto atom = Atoms::intern(style);
+
 	auto it = find(
 		this->styles.begin(),
 		this->styles.end(),
-		style
+		atom
 	);
 
 	if (it != this->styles.end()) {
 		return;
 	}
 
-	this->styles.push_back(style);
+	auto batched = this->batchTraits();
 
-	this->invalidateStyleTraits();
+	this->styles.push_back(atom);
+
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateStyleTraits(atom);
+	}
 }
 
 void
 DisplayNode::removeStyle(string style)
 {
+	/*
+	 * A style which name was never interned cannot have been appended,
+	 * looking it up does not grow the atom table.
+	 */
+
+	auto atom = Atoms::find(style);
+
+	if (atom == 0 &&
+		style.size()) {
+		return;
+	}
+
 	auto it = find(
 		this->styles.begin(),
 		this->styles.end(),
-		style
+		atom
 	);
 
 	if (it == this->styles.end()) {
 		return;
 	}
 
+	auto batched = this->batchTraits();
+
 	this->styles.erase(it);
 
-	this->invalidateStyleTraits();
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateStyleTraits(atom);
+	}
 }
 
 void
 DisplayNode::appendState(string state)
 {
+	auto atom = Atoms::intern(state);
+
 	auto it = find(
 		this->states.begin(),
 		this->states.end(),
-		state
+		atom
 	);
 
 	if (it != this->states.end()) {
 		return;
 	}
 
-	this->states.push_back(state);
+	auto batched = this->batchTraits();
+
+	this->states.push_back(atom);
 
-	this->invalidateStateTraits();
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateStateTraits(atom);
+	}
 }
 
 void
 DisplayNode::removeState(string state)
 {
+	/*
+	 * A state which name was never interned cannot have been appended,
+	 * looking it up does not grow the atom table.
+	 */
+
+	auto atom = Atoms::find(state);
+
+	if (atom == 0 &&
+		state.size()) {
+		return;
+	}
+
 	auto it = find(
 		this->states.begin(),
 		this->states.end(),
-		state
+		atom
 	);
 
 	if (it == this->states.end()) {
 		return;
 	}
 
+	auto batched = this->batchTraits();
+
 	this->states.erase(it);
 
-	this->invalidateStateTraits();
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateStateTraits(atom);
+	}
+}
+
+void
+DisplayNode::setStyles(const vector<Atom>& styles)
+{
+	auto batched = this->batchTraits();
+
+	vector<Atom> previous;
+
+	previous.swap(this->styles);
+
+	for (auto style : styles) {
+		if (find(this->styles.begin(), this->styles.end(), style) == this->styles.end()) {
+			this->styles.push_back(style);
+		}
+	}
+
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateChangedTraits(previous, this->states);
+	}
+}
+
+void
+DisplayNode::setStates(const vector<Atom>& states)
+{
+	auto batched = this->batchTraits();
+
+	vector<Atom> previous;
+
+	previous.swap(this->states);
+
+	for (auto state : states) {
+		if (find(this->states.begin(), this->states.end(), state) == this->states.end()) {
+			this->states.push_back(state);
+		}
+	}
+
+	this->touchTraits();
+
+	if (batched == false) {
+		this->invalidateChangedTraits(this->styles, previous);
+	}
 }
 
 void
@@ -2081,6 +2818,81 @@ DisplayNode::setContentDirection(ContentDirection direction)
 	}
 }
 
+void
+DisplayNode::setContentWrap(ContentWrap wrap)
+{
+	if (this->contentWrap == wrap) {
+		return;
+	}
+
+	this->contentWrap = wrap;
+
+	this->invalidateLayout();
+
+	if (this->isWrappingContentWidth() ||
+		this->isWrappingContentHeight()) {
+		this->invalidateSize();
+	}
+}
+
+void
+DisplayNode::setEstimatedItemExtent(double extent)
+{
+	extent = clamp(extent, 0, ABS_DBL_MAX);
+
+	if (this->virtualization == nullptr) {
+
+		if (extent == 0) {
+			return;
+		}
+
+		this->virtualization = new DisplayNodeVirtualization();
+	}
+
+	if (this->virtualization->estimate == extent) {
+		return;
+	}
+
+	this->virtualization->estimate = extent;
+
+	/*
+	 * Children skipped while the node was virtualized must be reachable
+	 * again by the resolve pass once it no longer is.
+	 */
+
+	if (extent == 0) {
+
+		for (auto child : this->children) {
+			if (child->offscreen) {
+				child->offscreen = false;
+				child->resolvedSize = false;
+			}
+		}
+	}
+
+	this->invalidateLayout();
+}
+
+void
+DisplayNode::setItemOverscan(double overscan)
+{
+	overscan = clamp(overscan, 0, ABS_DBL_MAX);
+
+	if (this->virtualization == nullptr) {
+
+		if (overscan == 0) {
+			return;
+		}
+
+		this->virtualization = new DisplayNodeVirtualization();
+	}
+
+	if (this->virtualization->overscan != overscan) {
+		this->virtualization->overscan = overscan;
+		this->invalidateLayout();
+	}
+}
+
 void
 DisplayNode::setContentAlignment(ContentAlignment alignment)
 {
@@ -2567,15 +3379,25 @@ DisplayNode::insertChild(DisplayNode* child, int index)
 
 	this->children.insert(this->children.begin() + index, child);
 
+	if (this->virtualization) {
+		this->virtualization->insert(index);
+	}
+
 	child->parent = this;
 
+	if (child->invalid ||
+		child->invalidDescendant) {
+		this->invalidateDescendant();
+	}
+
 	this->invalidateLayout();
 
 	const auto w = this->width.type;
 	const auto h = this->height.type;
 
-	if (w == kSizeTypeWrap ||
-		h == kSizeTypeWrap) {
+	if (this->isLayoutBoundary() == false && (
+		w == kSizeTypeWrap ||
+		h == kSizeTypeWrap)) {
 		this->invalidateSize();
 		this->invalidateOrigin();
 		this->invalidateParent();
@@ -2602,6 +3424,18 @@ DisplayNode::removeChild(DisplayNode* child)
 	}
 
 	child->parent = nullptr;
+	child->offscreen = false;
+
+	/*
+	 * The removed subtree can be deleted, the filters and style caches
+	 * holding any of its nodes must not use them anymore.
+	 */
+
+	this->touchTraits();
+
+	if (this->virtualization) {
+		this->virtualization->remove(it - this->children.begin());
+	}
 
 	this->children.erase(it);
 
@@ -2610,8 +3444,9 @@ DisplayNode::removeChild(DisplayNode* child)
 	const auto w = this->width.type;
 	const auto h = this->height.type;
 
-	if (w == kSizeTypeWrap ||
-		h == kSizeTypeWrap) {
+	if (this->isLayoutBoundary() == false && (
+		w == kSizeTypeWrap ||
+		h == kSizeTypeWrap)) {
 		this->invalidateSize();
 		this->invalidateOrigin();
 		this->invalidateParent();
@@ -2707,14 +3542,60 @@ DisplayNode::cleanup()
 	this->measuredContentHeightChanged = false;
 }
 
+size_t
+DisplayNode::getMemoryUsage() const
+{
+	/*
+	 * Reports the size of the node itself and of the heap storage it owns
+	 * directly. The properties are shared with the other nodes matching the
+	 * same descriptors and are owned by the stylesheet.
+	 */
+
+	size_t size = sizeof(DisplayNode);
+
+	size += this->children.capacity() * sizeof(DisplayNode*);
+	size += this->types.capacity() * sizeof(Atom);
+	size += this->styles.capacity() * sizeof(Atom);
+	size += this->states.capacity() * sizeof(Atom);
+
+	if (this->measureCache) {
+		size += sizeof(DisplayNodeMeasureCache);
+	}
+
+	if (this->virtualization) {
+		size += this->virtualization->getMemoryUsage();
+	}
+
+	return size;
+}
+
 void
 DisplayNode::reset()
 {
-	for (auto property : this->properties) {
-		this->updateProperty(property->getName(), nullptr);
+	if (this->properties == nullptr) {
+		return;
 	}
 
-	this->properties.clear();
+	/*
+	 * The properties are removed in the order they were declared, as they
+	 * would be by a diff with an empty list.
+	 */
+
+	static const PropertyList none;
+
+	PropertyDiff diff;
+
+	this->properties->diffs(none, diff);
+
+	for (auto property : diff.removes) {
+		this->applyProperty(property, nullptr);
+	}
+
+	this->properties->release();
+	this->properties = nullptr;
+
+	this->stylesheet->release();
+	this->stylesheet = nullptr;
 }
 
 string
@@ -2722,13 +3603,13 @@ DisplayNode::toString()
 {
 	string output;
 
-	if (this->name.length() > 0) {
+	if (this->name) {
 		output.append("#");
-		output.append(this->name);
+		output.append(Atoms::resolve(this->name));
 	}
 
 	output.append("[");
-	output.append(this->type);
+	output.append(Atoms::resolve(this->type));
 	output.append("]");
 
 	if (this->styles.size() > 0) {
@@ -2736,8 +3617,8 @@ DisplayNode::toString()
 		output.append(" ");
 		output.append("Style: ");
 
-		for (auto & style : this->styles) {
-			output.append(style);
+		for (auto style : this->styles) {
+			output.append(Atoms::resolve(style));
 			output.append(" ");
 		}
 	}
@@ -2747,8 +3628,8 @@ DisplayNode::toString()
 		output.append(" ");
 		output.append("State: ");
 
-		for (auto & state : this->states) {
-			output.append(state);
+		for (auto state : this->states) {
+			output.append(Atoms::resolve(state));
 			output.append(" ");
 		}
 	}
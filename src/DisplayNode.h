@@ -10,12 +10,15 @@
 #include "DisplayNodePadding.h"
 #include "DisplayNodeContentSize.h"
 #include "DisplayNodeContentOrigin.h"
+#include "DisplayNodeMeasureCache.h"
+#include "DisplayNodeVirtualization.h"
 #include "LayoutResolver.h"
 #include "RelativeLayoutResolver.h"
 #include "AbsoluteLayoutResolver.h"
 #include "PropertyList.h"
 #include "Property.h"
 #include "Match.h"
+#include "Atom.h"
 
 #include <iostream>
 #include <float.h>
@@ -31,6 +34,8 @@ namespace Style {
 	class Fragment;
 	class Property;
 	class PropertyList;
+	class Stylesheet;
+	class InvalidationSet;
 }
 
 using std::string;
@@ -41,16 +46,22 @@ using Layout::AbsoluteLayoutResolver;
 using Layout::RelativeLayoutResolver;
 
 using Style::Descriptor;
+using Style::Atom;
+using Style::Atoms;
 using Style::Selector;
 using Style::Fragment;
 using Style::PropertyList;
+using Style::Stylesheet;
+using Style::InvalidationSet;
 using Style::Property;
 using Style::Match;
 
 typedef enum {
 	kDisplayNodeFlagNone   = 0,
 	kDisplayNodeFlagOpaque = 1 << 0,
-	kDisplayNodeFlagWindow = 1 << 1
+	kDisplayNodeFlagWindow = 1 << 1,
+	kDisplayNodeFlagThreadSafe = 1 << 2,
+	kDisplayNodeFlagLayoutBoundary = 1 << 3
 } DisplayNodeFlag;
 
 inline DisplayNodeFlag operator|(DisplayNodeFlag a, DisplayNodeFlag b)
@@ -58,52 +69,124 @@ inline DisplayNodeFlag operator|(DisplayNodeFlag a, DisplayNodeFlag b)
 	return static_cast<DisplayNodeFlag>(static_cast<int>(a) | static_cast<int>(b));
 }
 
+inline DisplayNodeFlag operator&(DisplayNodeFlag a, DisplayNodeFlag b)
+{
+	return static_cast<DisplayNodeFlag>(static_cast<int>(a) & static_cast<int>(b));
+}
+
+inline DisplayNodeFlag operator~(DisplayNodeFlag a)
+{
+	return static_cast<DisplayNodeFlag>(~static_cast<int>(a));
+}
+
 class Display;
 
 class DisplayNode {
 
 private:
 
+	/*
+	 * The members are grouped by how often they are accessed while the
+	 * tree is resolved. The invalidation and changed states are single
+	 * bits that share one word and are initialized by the constructor.
+	 */
+
 	DisplayNodeFlag flags = kDisplayNodeFlagNone;
 
+	bool invalid : 1;
+	bool invalidDescendant : 1;
+	bool invalidSize : 1;
+	bool invalidOrigin : 1;
+	bool invalidMargin : 1;
+	bool invalidBorder : 1;
+	bool invalidInnerSize : 1;
+	bool invalidContentSize : 1;
+	bool invalidContentOrigin : 1;
+	bool invalidPadding : 1;
+	bool invalidExtent : 1;
+	bool invalidLayout : 1;
+	bool invalidTraits : 1;
+	bool scheduled : 1;
+	bool resolving : 1;
+	bool resolvedSize : 1;
+	bool resolvedOrigin : 1;
+	bool inheritedWrappedContentWidth : 1;
+	bool inheritedWrappedContentHeight : 1;
+	bool measuredWidthChanged : 1;
+	bool measuredHeightChanged : 1;
+	bool measuredInnerWidthChanged : 1;
+	bool measuredInnerHeightChanged : 1;
+	bool measuredContentWidthChanged : 1;
+	bool measuredContentHeightChanged : 1;
+	bool offscreen : 1;
+	bool batchedTraits : 1;
+	bool pendingTraits : 1;
+
+	bool visible = true;
+
+	unsigned int changes = kDisplayNodeChangeNone;
+
 	Display* display = nullptr;
 
-	DisplayNode* window = nullptr;
 	DisplayNode* parent = nullptr;
-    vector<DisplayNode*> children;
-
-	string name = "";
-	string type = "";
+	DisplayNode* resolvedParent = nullptr;
+	vector<DisplayNode*> children;
 
-	vector<string> types;
-	vector<string> styles;
-	vector<string> states;
+	double measuredTop = 0;
+	double measuredLeft = 0;
+	double measuredRight = 0;
+	double measuredBottom = 0;
+	double measuredWidth = 0;
+	double measuredHeight = 0;
+	double measuredInnerWidth = 0;
+	double measuredInnerHeight = 0;
+	double measuredContentTop = 0;
+	double measuredContentLeft = 0;
+	double measuredContentWidth = 0;
+	double measuredContentHeight = 0;
+	double measuredBorderTop = 0;
+	double measuredBorderLeft = 0;
+	double measuredBorderRight = 0;
+	double measuredBorderBottom = 0;
+	double measuredMarginTop = 0;
+	double measuredMarginLeft = 0;
+	double measuredMarginRight = 0;
+	double measuredMarginBottom = 0;
+	double measuredPaddingTop = 0;
+	double measuredPaddingLeft = 0;
+	double measuredPaddingRight = 0;
+	double measuredPaddingBottom = 0;
 
-	bool visible = true;
+	double lastMeasuredWidth = 0;
+	double lastMeasuredHeight = 0;
 
-	DisplayNodeAnchor anchorTop;
-	DisplayNodeAnchor anchorLeft;
+	DisplayNodeSize width;
+	DisplayNodeSize height;
 
 	DisplayNodeOrigin top;
 	DisplayNodeOrigin left;
 	DisplayNodeOrigin right;
 	DisplayNodeOrigin bottom;
 
-	DisplayNodeSize width;
-	DisplayNodeSize height;
-
 	ContentDirection contentDirection = kContentDirectionVertical;
+	ContentWrap contentWrap = kContentWrapNone;
 	ContentAlignment contentAlignment = kContentAlignmentStart;
 	ContentDisposition contentDisposition = kContentDispositionStart;
 
+	double expandFactor = 0;
+	double shrinkFactor = 0;
+
+	DisplayNodeAnchor anchorTop;
+	DisplayNodeAnchor anchorLeft;
+
 	DisplayNodeContentOrigin contentTop;
 	DisplayNodeContentOrigin contentLeft;
 	DisplayNodeContentSize contentWidth;
 	DisplayNodeContentSize contentHeight;
 
-    DisplayNodeBorder borderTop;
-    DisplayNodeBorder borderLeft;
-    DisplayNodeBorder borderRight;
+	DisplayNodeBorder borderTop;
+	DisplayNodeBorder borderLeft;
+	DisplayNodeBorder borderRight;
 	DisplayNodeBorder borderBottom;
 
 	DisplayNodeMargin marginTop;
@@ -116,25 +199,27 @@ private:
 	DisplayNodePadding paddingRight;
 	DisplayNodePadding paddingBottom;
 
-    double expandFactor = 0;
-	double shrinkFactor = 0;
+	LayoutResolver layout;
+
+	DisplayNodeMeasureCache* measureCache = nullptr;
+	DisplayNodeVirtualization* virtualization = nullptr;
+
+	Atom name = 0;
+	Atom type = 0;
+
+	vector<Atom> types;
+	vector<Atom> styles;
+	vector<Atom> states;
+
+	/*
+	 * The properties and the pending properties are retained by the node,
+	 * as is the stylesheet they were allocated from.
+	 */
+
+	const PropertyList* properties = nullptr;
+	const PropertyList* pendingProperties = nullptr;
 
-	bool invalid = false;
-   	bool invalidSize = false;
-	bool invalidOrigin = false;
-	bool invalidMargin = false;
-	bool invalidBorder = false;
-	bool invalidInnerSize = false;
-	bool invalidContentSize = false;
-	bool invalidContentOrigin = false;
-	bool invalidPadding = false;
-	bool invalidExtent = false;
-	bool invalidLayout = false;
-	bool invalidTraits = false;
-	bool invalidStyleTraits = false;
-	bool invalidStateTraits = false;
-
-	PropertyList properties;
+	Stylesheet* stylesheet = nullptr;
 
 	DisplayNodeCallback invalidateCallback = nullptr;
 	DisplayNodeCallback resolveSizeCallback = nullptr;
@@ -149,53 +234,8 @@ private:
 	DisplayNodeMeasureCallback measureCallback = nullptr;
 	DisplayNodeUpdateCallback updateCallback = nullptr;
 
-	LayoutResolver layout;
-
-	bool resolving = false;
-	bool resolvedSize = false;
-	bool resolvedOrigin = false;
-
-	DisplayNode* resolvedParent = nullptr;
-	DisplayNode* resolvedWindow = nullptr;
-
-	bool inheritedWrappedContentWidth = false;
-	bool inheritedWrappedContentHeight = false;
-
-	bool measuredWidthChanged = false;
-	bool measuredHeightChanged = false;
-	bool measuredInnerWidthChanged = false;
-	bool measuredInnerHeightChanged = false;
-	bool measuredContentWidthChanged = false;
-	bool measuredContentHeightChanged = false;
-
-    double measuredTop = 0;
-	double measuredLeft = 0;
-	double measuredRight = 0;
-	double measuredBottom = 0;
-	double measuredWidth = 0;
-	double measuredHeight = 0;
-    double measuredInnerWidth = 0;
-    double measuredInnerHeight = 0;
-    double measuredContentTop = 0;
-    double measuredContentLeft = 0;
-	double measuredContentWidth = 0;
-	double measuredContentHeight = 0;
-    double measuredBorderTop = 0;
-    double measuredBorderLeft = 0;
-    double measuredBorderRight = 0;
-    double measuredBorderBottom = 0;
-	double measuredMarginTop = 0;
-	double measuredMarginLeft = 0;
-	double measuredMarginRight = 0;
-	double measuredMarginBottom = 0;
-	double measuredPaddingTop = 0;
-	double measuredPaddingLeft = 0;
-	double measuredPaddingRight = 0;
-	double measuredPaddingBottom = 0;
-
-	double lastMeasuredWidth = 0;
-	double lastMeasuredHeight = 0;
-
+	void detach();
+	void touchTraits();
 	void explode(string type);
 
 protected:
@@ -218,9 +258,16 @@ protected:
 	void invalidatePadding();
 	void invalidateExtent();
 	void invalidateParent();
+	void invalidateDescendant();
 	void invalidateTraits();
-	void invalidateStyleTraits();
-	void invalidateStateTraits();
+	void invalidateStyleTraits(Atom style);
+	void invalidateStateTraits(Atom state);
+	void invalidateChangedTraits(const vector<Atom>& styles, const vector<Atom>& states);
+	void invalidateDescendantTraits(const vector<const InvalidationSet*>& invalidations);
+
+	bool batchTraits();
+
+	const PropertyList* matchTraits();
 
 	bool inheritsWrappedWidth();
 	bool inheritsWrappedHeight();
@@ -263,51 +310,76 @@ protected:
 		return this->resolvedParent != this->parent;
 	}
 
+	void notify(DisplayNodeCallback callback);
+	void dispatch(DisplayNodeCallback callback);
+	void journal(DisplayNodeChange change);
+
 	void didInvalidate() {
 		if (this->invalidateCallback) {
-			this->invalidateCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->notify(this->invalidateCallback);
 		}
 	}
 
 	void didResolveSize() {
+
+		this->journal(kDisplayNodeChangeSize);
+
 		if (this->resolveSizeCallback) {
-			this->resolveSizeCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveSizeCallback);
 		}
 	}
 
 	void didResolveOrigin() {
+
+		this->journal(kDisplayNodeChangeOrigin);
+
 		if (this->resolveOriginCallback) {
-			this->resolveOriginCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveOriginCallback);
 		}
 	}
 
 	void didResolveInnerSize() {
+
+		this->journal(kDisplayNodeChangeInnerSize);
+
 		if (this->resolveInnerSizeCallback) {
-			this->resolveInnerSizeCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveInnerSizeCallback);
 		}
 	}
 
 	void didResolveContentSize() {
+
+		this->journal(kDisplayNodeChangeContentSize);
+
 		if (this->resolveContentSizeCallback) {
-			this->resolveContentSizeCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveContentSizeCallback);
 		}
 	}
 
 	void didResolveMargins() {
+
+		this->journal(kDisplayNodeChangeMargins);
+
 		if (this->resolveMarginsCallback) {
-			this->resolveMarginsCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveMarginsCallback);
 		}
 	}
 
 	void didResolveBorders() {
+
+		this->journal(kDisplayNodeChangeBorders);
+
 		if (this->resolveBordersCallback) {
-			this->resolveBordersCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveBordersCallback);
 		}
 	}
 
 	void didResolvePadding() {
+
+		this->journal(kDisplayNodeChangePadding);
+
 		if (this->resolvePaddingCallback) {
-			this->resolvePaddingCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolvePaddingCallback);
 		}
 	}
 
@@ -318,16 +390,17 @@ protected:
 	}
 
 	void didResolveLayout() {
+
+		this->journal(kDisplayNodeChangeLayout);
+
 		if (this->resolveLayoutCallback) {
-			this->resolveLayoutCallback(reinterpret_cast<DisplayNodeRef>(this));
+			this->dispatch(this->resolveLayoutCallback);
 		}
 	}
 
-	void measure(MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh) {
-		if (this->measureCallback) {
-			this->measureCallback(reinterpret_cast<DisplayNodeRef>(this), size, w, h, minw, maxw, minh, maxh);
-		}
-	}
+	void measure(MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh);
+
+	bool applyProperty(const Property* previous, Property* property);
 
 	void updateProperty(string name, Property* property) {
 		if (this->updateCallback) {
@@ -342,6 +415,7 @@ protected:
 public:
 
 	friend class Display;
+	friend class DisplayNodeStyleCache;
 	friend class LayoutResolver;
 	friend class RelativeLayoutResolver;
 	friend class AbsoluteLayoutResolver;
@@ -352,9 +426,9 @@ public:
 	DisplayNode(Display* display);
 	DisplayNode(Display* display, string type);
 
-	void setDisplay(Display* display) {
-		this->display = display;
-	}
+	~DisplayNode();
+
+	void setDisplay(Display* display);
 
 	void setWindow() {
 		this->flags = this->flags | kDisplayNodeFlagWindow;
@@ -364,6 +438,18 @@ public:
 		this->flags = this->flags | kDisplayNodeFlagOpaque;
 	}
 
+	void setLayoutBoundary(bool layoutBoundary) {
+		this->flags = layoutBoundary ?
+			this->flags | kDisplayNodeFlagLayoutBoundary :
+			this->flags & ~kDisplayNodeFlagLayoutBoundary;
+	}
+
+	void setThreadSafe(bool threadSafe) {
+		this->flags = threadSafe ?
+			this->flags | kDisplayNodeFlagThreadSafe :
+			this->flags & ~kDisplayNodeFlagThreadSafe;
+	}
+
 	DisplayNode* getParent() const {
 		return this->parent;
 	}
@@ -378,12 +464,14 @@ public:
 	void removeStyle(string style);
 	void appendState(string state);
 	void removeState(string state);
+	void setStyles(const vector<Atom>& styles);
+	void setStates(const vector<Atom>& states);
 
 	bool hasStyle(string style) {
 		return find(
 			this->styles.begin(),
 			this->styles.end(),
-			style
+			Atoms::find(style)
 		) != this->styles.end();
 	}
 
@@ -391,27 +479,27 @@ public:
 		return find(
 			this->states.begin(),
 			this->states.end(),
-			state
+			Atoms::find(state)
 		) != this->states.end();
 	}
 
-	const string& getName() const {
+	Atom getName() const {
 		return this->name;
 	}
 
-	const string& getType() const {
+	Atom getType() const {
 		return this->type;
 	}
 
-	const vector<string>& getTypes() const {
+	const vector<Atom>& getTypes() const {
 		return this->types;
 	}
 
-	const vector<string>& getStyles() const {
+	const vector<Atom>& getStyles() const {
 		return this->styles;
 	}
 
-	const vector<string>& getStates() const {
+	const vector<Atom>& getStates() const {
 		return this->states;
 	}
 
@@ -443,6 +531,9 @@ public:
 	void setMaxHeight(double max);
 
 	void setContentDirection(ContentDirection direction);
+	void setContentWrap(ContentWrap wrap);
+	void setEstimatedItemExtent(double extent);
+	void setItemOverscan(double overscan);
 	void setContentAlignment(ContentAlignment alignment);
 	void setContentDisposition(ContentDisposition placement);
 
@@ -528,7 +619,12 @@ public:
 	}
 
 	void setMeasureCallback(DisplayNodeMeasureCallback callback) {
+
 		this->measureCallback = callback;
+
+		if (this->measureCache) {
+			this->measureCache->clear();
+		}
 	}
 
 	void setUpdateCallback(DisplayNodeUpdateCallback callback) {
@@ -639,6 +735,14 @@ public:
 		return this->flags & kDisplayNodeFlagWindow;
 	}
 
+	bool isThreadSafe() const {
+		return this->flags & kDisplayNodeFlagThreadSafe;
+	}
+
+	bool isLayoutBoundary();
+
+	size_t getMemoryUsage() const;
+
 	bool isRelative() const {
 		return (
 			this->top.type == kOriginTypeAuto &&
@@ -673,9 +777,14 @@ public:
 		return this->height.type == kSizeTypeWrap;
 	}
 
+	bool isVirtualized() const {
+		return this->virtualization && this->virtualization->estimate > 0;
+	}
+
 	void invalidateSize();
 	void invalidateOrigin();
 	void invalidateLayout();
+	void invalidateMeasure();
 
 	void measure();
 	void resolve();
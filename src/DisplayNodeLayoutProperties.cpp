@@ -0,0 +1,385 @@
+#include "DisplayNodeLayoutProperties.h"
+#include "DisplayNode.h"
+#include "Property.h"
+#include "Value.h"
+
+#include <utility>
+
+namespace Dezel {
+
+using std::pair;
+using Style::Atoms;
+using Style::Value;
+
+typedef DisplayNodeLayoutValue LayoutValue;
+
+//------------------------------------------------------------------------------
+// MARK: Decoders
+//------------------------------------------------------------------------------
+
+namespace Decoders {
+
+static const Value* single(const Property* property)
+{
+	auto& values = property->getValues();
+	return values.size() == 1 ? &values[0] : nullptr;
+}
+
+static bool keyword(const Value* value, Atom name)
+{
+	return (
+		value &&
+		value->getType() == kValueTypeString &&
+		value->getAtom() == name
+	);
+}
+
+static bool number(const Value* value, LayoutValue& result)
+{
+	/*
+	 * The units of the sized types share the numbering of the value units
+	 * and a number without unit is given in pixels.
+	 */
+
+	if (value == nullptr ||
+		value->getType() != kValueTypeNumber) {
+		return false;
+	}
+
+	auto unit = value->getUnit();
+
+	if (unit == kValueUnitDeg ||
+		unit == kValueUnitRad) {
+		return false;
+	}
+
+	result.unit = unit == kValueUnitNone ? kValueUnitPX : unit;
+	result.length = value->getNumber();
+
+	return true;
+}
+
+static bool keywords(const Property* property, LayoutValue& result, const Atom names[], size_t count)
+{
+	auto value = single(property);
+
+	for (size_t i = 0; i < count; i++) {
+		if (keyword(value, names[i])) {
+			result.type = static_cast<int>(i + 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool size(const Property* property, LayoutValue& result)
+{
+	static const Atom fill = Atoms::intern("fill");
+	static const Atom wrap = Atoms::intern("wrap");
+
+	auto value = single(property);
+
+	if (keyword(value, fill)) {
+		result = {kSizeTypeFill, kSizeUnitNone, 0};
+		return true;
+	}
+
+	if (keyword(value, wrap)) {
+		result = {kSizeTypeWrap, kSizeUnitNone, 0};
+		return true;
+	}
+
+	result.type = kSizeTypeLength;
+
+	return number(value, result);
+}
+
+static bool origin(const Property* property, LayoutValue& result)
+{
+	static const Atom automatic = Atoms::intern("auto");
+
+	auto value = single(property);
+
+	if (keyword(value, automatic)) {
+		result = {kOriginTypeAuto, kOriginUnitNone, 0};
+		return true;
+	}
+
+	result.type = kOriginTypeLength;
+
+	return number(value, result);
+}
+
+static bool contentSize(const Property* property, LayoutValue& result)
+{
+	static const Atom automatic = Atoms::intern("auto");
+
+	auto value = single(property);
+
+	if (keyword(value, automatic)) {
+		result = {kContentSizeTypeAuto, kContentSizeUnitNone, 0};
+		return true;
+	}
+
+	result.type = kContentSizeTypeLength;
+
+	return number(value, result);
+}
+
+static bool contentOrigin(const Property* property, LayoutValue& result)
+{
+	if (number(single(property), result) == false ||
+		result.unit != kValueUnitPX) {
+		return false;
+	}
+
+	result.type = kContentOriginTypeLength;
+	result.unit = kContentOriginUnitPX;
+
+	return true;
+}
+
+static bool length(const Property* property, LayoutValue& result)
+{
+	/*
+	 * The anchors, borders, margins and paddings only have a length type
+	 * and their units start with pixels.
+	 */
+
+	if (number(single(property), result) == false) {
+		return false;
+	}
+
+	result.type = 1;
+	result.unit = result.unit - 1;
+
+	return true;
+}
+
+static bool scalar(const Property* property, LayoutValue& result)
+{
+	if (number(single(property), result) == false ||
+		result.unit != kValueUnitPX) {
+		return false;
+	}
+
+	result.type = 0;
+	result.unit = 0;
+
+	return true;
+}
+
+static bool contentDirection(const Property* property, LayoutValue& result)
+{
+	static const Atom names[] = {
+		Atoms::intern("vertical"),
+		Atoms::intern("horizontal")
+	};
+
+	return keywords(property, result, names, 2);
+}
+
+static bool contentWrap(const Property* property, LayoutValue& result)
+{
+	static const Atom names[] = {
+		Atoms::intern("none"),
+		Atoms::intern("lines")
+	};
+
+	return keywords(property, result, names, 2);
+}
+
+static bool contentAlignment(const Property* property, LayoutValue& result)
+{
+	static const Atom names[] = {
+		Atoms::intern("start"),
+		Atoms::intern("center"),
+		Atoms::intern("end")
+	};
+
+	return keywords(property, result, names, 3);
+}
+
+static bool contentDisposition(const Property* property, LayoutValue& result)
+{
+	static const Atom names[] = {
+		Atoms::intern("start"),
+		Atoms::intern("center"),
+		Atoms::intern("end"),
+		Atoms::intern("space-around"),
+		Atoms::intern("space-between"),
+		Atoms::intern("space-evenly")
+	};
+
+	return keywords(property, result, names, 6);
+}
+
+}
+
+//------------------------------------------------------------------------------
+// MARK: Properties
+//------------------------------------------------------------------------------
+
+namespace Properties {
+
+static const LayoutValue none = {0, 0, 0};
+static const LayoutValue lowest = {0, 0, ABS_DBL_MIN};
+static const LayoutValue highest = {0, 0, ABS_DBL_MAX};
+
+static const pair<const char*, DisplayNodeLayoutProperty> list[] = {
+
+	{"width", {Decoders::size, [](DisplayNode* node, const LayoutValue& value) { node->setWidth(SizeType(value.type), SizeUnit(value.unit), value.length); }, {kSizeTypeFill, kSizeUnitNone, 0}}},
+	{"height", {Decoders::size, [](DisplayNode* node, const LayoutValue& value) { node->setHeight(SizeType(value.type), SizeUnit(value.unit), value.length); }, {kSizeTypeFill, kSizeUnitNone, 0}}},
+	{"minWidth", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinWidth(value.length); }, none}},
+	{"maxWidth", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxWidth(value.length); }, highest}},
+	{"minHeight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinHeight(value.length); }, none}},
+	{"maxHeight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxHeight(value.length); }, highest}},
+
+	{"top", {Decoders::origin, [](DisplayNode* node, const LayoutValue& value) { node->setTop(OriginType(value.type), OriginUnit(value.unit), value.length); }, {kOriginTypeAuto, kOriginUnitNone, 0}}},
+	{"left", {Decoders::origin, [](DisplayNode* node, const LayoutValue& value) { node->setLeft(OriginType(value.type), OriginUnit(value.unit), value.length); }, {kOriginTypeAuto, kOriginUnitNone, 0}}},
+	{"right", {Decoders::origin, [](DisplayNode* node, const LayoutValue& value) { node->setRight(OriginType(value.type), OriginUnit(value.unit), value.length); }, {kOriginTypeAuto, kOriginUnitNone, 0}}},
+	{"bottom", {Decoders::origin, [](DisplayNode* node, const LayoutValue& value) { node->setBottom(OriginType(value.type), OriginUnit(value.unit), value.length); }, {kOriginTypeAuto, kOriginUnitNone, 0}}},
+	{"minTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinTop(value.length); }, lowest}},
+	{"maxTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxTop(value.length); }, highest}},
+	{"minLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinLeft(value.length); }, lowest}},
+	{"maxLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxLeft(value.length); }, highest}},
+	{"minRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinRight(value.length); }, lowest}},
+	{"maxRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxRight(value.length); }, highest}},
+	{"minBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinBottom(value.length); }, lowest}},
+	{"maxBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxBottom(value.length); }, highest}},
+
+	{"anchorTop", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setAnchorTop(AnchorType(value.type), AnchorUnit(value.unit), value.length); }, {kAnchorTypeLength, kAnchorUnitPC, 0}}},
+	{"anchorLeft", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setAnchorLeft(AnchorType(value.type), AnchorUnit(value.unit), value.length); }, {kAnchorTypeLength, kAnchorUnitPC, 0}}},
+
+	{"contentDirection", {Decoders::contentDirection, [](DisplayNode* node, const LayoutValue& value) { node->setContentDirection(ContentDirection(value.type)); }, {kContentDirectionVertical, 0, 0}}},
+	{"contentWrap", {Decoders::contentWrap, [](DisplayNode* node, const LayoutValue& value) { node->setContentWrap(ContentWrap(value.type)); }, {kContentWrapNone, 0, 0}}},
+	{"contentAlignment", {Decoders::contentAlignment, [](DisplayNode* node, const LayoutValue& value) { node->setContentAlignment(ContentAlignment(value.type)); }, {kContentAlignmentStart, 0, 0}}},
+	{"contentDisposition", {Decoders::contentDisposition, [](DisplayNode* node, const LayoutValue& value) { node->setContentDisposition(ContentDisposition(value.type)); }, {kContentDispositionStart, 0, 0}}},
+
+	{"contentTop", {Decoders::contentOrigin, [](DisplayNode* node, const LayoutValue& value) { node->setContentTop(ContentOriginType(value.type), ContentOriginUnit(value.unit), value.length); }, {kContentOriginTypeLength, kContentOriginUnitNone, 0}}},
+	{"contentLeft", {Decoders::contentOrigin, [](DisplayNode* node, const LayoutValue& value) { node->setContentLeft(ContentOriginType(value.type), ContentOriginUnit(value.unit), value.length); }, {kContentOriginTypeLength, kContentOriginUnitNone, 0}}},
+	{"contentWidth", {Decoders::contentSize, [](DisplayNode* node, const LayoutValue& value) { node->setContentWidth(ContentSizeType(value.type), ContentSizeUnit(value.unit), value.length); }, {kContentSizeTypeAuto, kContentSizeUnitNone, 0}}},
+	{"contentHeight", {Decoders::contentSize, [](DisplayNode* node, const LayoutValue& value) { node->setContentHeight(ContentSizeType(value.type), ContentSizeUnit(value.unit), value.length); }, {kContentSizeTypeAuto, kContentSizeUnitNone, 0}}},
+
+	{"expandFactor", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setExpandFactor(value.length); }, none}},
+	{"shrinkFactor", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setShrinkFactor(value.length); }, none}},
+
+	{"borderTop", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setBorderTop(BorderType(value.type), BorderUnit(value.unit), value.length); }, {kBorderTypeLength, kBorderUnitPX, 0}}},
+	{"borderLeft", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setBorderLeft(BorderType(value.type), BorderUnit(value.unit), value.length); }, {kBorderTypeLength, kBorderUnitPX, 0}}},
+	{"borderRight", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setBorderRight(BorderType(value.type), BorderUnit(value.unit), value.length); }, {kBorderTypeLength, kBorderUnitPX, 0}}},
+	{"borderBottom", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setBorderBottom(BorderType(value.type), BorderUnit(value.unit), value.length); }, {kBorderTypeLength, kBorderUnitPX, 0}}},
+
+	{"marginTop", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setMarginTop(MarginType(value.type), MarginUnit(value.unit), value.length); }, {kMarginTypeLength, kMarginUnitPX, 0}}},
+	{"marginLeft", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setMarginLeft(MarginType(value.type), MarginUnit(value.unit), value.length); }, {kMarginTypeLength, kMarginUnitPX, 0}}},
+	{"marginRight", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setMarginRight(MarginType(value.type), MarginUnit(value.unit), value.length); }, {kMarginTypeLength, kMarginUnitPX, 0}}},
+	{"marginBottom", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setMarginBottom(MarginType(value.type), MarginUnit(value.unit), value.length); }, {kMarginTypeLength, kMarginUnitPX, 0}}},
+	{"minMarginTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinMarginTop(value.length); }, lowest}},
+	{"maxMarginTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxMarginTop(value.length); }, highest}},
+	{"minMarginLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinMarginLeft(value.length); }, lowest}},
+	{"maxMarginLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxMarginLeft(value.length); }, highest}},
+	{"minMarginRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinMarginRight(value.length); }, lowest}},
+	{"maxMarginRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxMarginRight(value.length); }, highest}},
+	{"minMarginBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinMarginBottom(value.length); }, lowest}},
+	{"maxMarginBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxMarginBottom(value.length); }, highest}},
+
+	{"paddingTop", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setPaddingTop(PaddingType(value.type), PaddingUnit(value.unit), value.length); }, {kPaddingTypeLength, kPaddingUnitPX, 0}}},
+	{"paddingLeft", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setPaddingLeft(PaddingType(value.type), PaddingUnit(value.unit), value.length); }, {kPaddingTypeLength, kPaddingUnitPX, 0}}},
+	{"paddingRight", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setPaddingRight(PaddingType(value.type), PaddingUnit(value.unit), value.length); }, {kPaddingTypeLength, kPaddingUnitPX, 0}}},
+	{"paddingBottom", {Decoders::length, [](DisplayNode* node, const LayoutValue& value) { node->setPaddingBottom(PaddingType(value.type), PaddingUnit(value.unit), value.length); }, {kPaddingTypeLength, kPaddingUnitPX, 0}}},
+	{"minPaddingTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinPaddingTop(value.length); }, none}},
+	{"maxPaddingTop", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxPaddingTop(value.length); }, highest}},
+	{"minPaddingLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinPaddingLeft(value.length); }, none}},
+	{"maxPaddingLeft", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxPaddingLeft(value.length); }, highest}},
+	{"minPaddingRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinPaddingRight(value.length); }, none}},
+	{"maxPaddingRight", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxPaddingRight(value.length); }, highest}},
+	{"minPaddingBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMinPaddingBottom(value.length); }, none}},
+	{"maxPaddingBottom", {Decoders::scalar, [](DisplayNode* node, const LayoutValue& value) { node->setMaxPaddingBottom(value.length); }, highest}},
+
+};
+
+}
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+const vector<const DisplayNodeLayoutProperty*>&
+DisplayNodeLayoutProperties::table()
+{
+	static const vector<const DisplayNodeLayoutProperty*> table = [] {
+
+		vector<const DisplayNodeLayoutProperty*> table;
+
+		for (auto& entry : Properties::list) {
+
+			auto id = Atoms::intern(entry.first);
+
+			if (table.size() <= id) {
+				table.resize(id + 1, nullptr);
+			}
+
+			table[id] = &entry.second;
+		}
+
+		return table;
+
+	}();
+
+	return table;
+}
+
+const DisplayNodeLayoutProperty*
+DisplayNodeLayoutProperties::find(Atom id)
+{
+	auto& table = DisplayNodeLayoutProperties::table();
+	return id < table.size() ? table[id] : nullptr;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+bool
+DisplayNodeLayoutProperties::accepts(const Property* property)
+{
+	/*
+	 * A layout property which value cannot be decoded, such as a variable
+	 * that was not defined, is still given to the host.
+	 */
+
+	auto entry = DisplayNodeLayoutProperties::find(property->getId());
+
+	if (entry == nullptr) {
+		return false;
+	}
+
+	LayoutValue value;
+
+	return entry->decode(property, value);
+}
+
+void
+DisplayNodeLayoutProperties::apply(DisplayNode* node, const Property* property)
+{
+	auto entry = DisplayNodeLayoutProperties::find(property->getId());
+
+	LayoutValue value;
+
+	if (entry &&
+		entry->decode(property, value)) {
+		entry->apply(node, value);
+	}
+}
+
+void
+DisplayNodeLayoutProperties::reset(DisplayNode* node, const Property* property)
+{
+	auto entry = DisplayNodeLayoutProperties::find(property->getId());
+
+	if (entry) {
+		entry->apply(node, entry->initial);
+	}
+}
+
+}
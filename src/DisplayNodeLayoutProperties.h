@@ -0,0 +1,64 @@
+#ifndef DisplayNodeLayoutProperties_h
+#define DisplayNodeLayoutProperties_h
+
+#include "Atom.h"
+
+#include <vector>
+
+namespace Dezel {
+
+namespace Style {
+	class Property;
+}
+
+using std::vector;
+using Style::Atom;
+using Style::Property;
+
+class DisplayNode;
+
+/**
+ * The value of a layout property decoded into the type, unit and length
+ * given to the display node setter.
+ */
+struct DisplayNodeLayoutValue {
+	int type;
+	int unit;
+	double length;
+};
+
+/**
+ * Decodes a layout property and applies it to a display node. The initial
+ * value is applied when the property is removed.
+ */
+struct DisplayNodeLayoutProperty {
+	bool (*decode)(const Property* property, DisplayNodeLayoutValue& value);
+	void (*apply)(DisplayNode* node, const DisplayNodeLayoutValue& value);
+	DisplayNodeLayoutValue initial;
+};
+
+class DisplayNodeLayoutProperties {
+
+private:
+
+	/*
+	 * The table is indexed by the atom of the property name. The atoms are
+	 * interned once when the table is built, a property interned later is
+	 * past its end and cannot be a layout property.
+	 */
+
+	static const vector<const DisplayNodeLayoutProperty*>& table();
+
+	static const DisplayNodeLayoutProperty* find(Atom id);
+
+public:
+
+	static bool accepts(const Property* property);
+	static void apply(DisplayNode* node, const Property* property);
+	static void reset(DisplayNode* node, const Property* property);
+
+};
+
+}
+
+#endif
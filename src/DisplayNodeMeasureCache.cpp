@@ -0,0 +1,55 @@
+#include "DisplayNodeMeasureCache.h"
+
+namespace Dezel {
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+bool
+DisplayNodeMeasureCache::find(MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh) const
+{
+	for (size_t i = 0; i < this->count; i++) {
+
+		auto& entry = this->entries[i];
+
+		if (entry.w == w &&
+			entry.h == h &&
+			entry.minw == minw &&
+			entry.maxw == maxw &&
+			entry.minh == minh &&
+			entry.maxh == maxh) {
+			*size = entry.size;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+DisplayNodeMeasureCache::store(const MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh)
+{
+	/*
+	 * The cache holds the most recent constraints only, the oldest entry
+	 * is replaced once every slot has been used.
+	 */
+
+	auto& entry = this->entries[this->next];
+
+	entry.w = w;
+	entry.h = h;
+	entry.minw = minw;
+	entry.maxw = maxw;
+	entry.minh = minh;
+	entry.maxh = maxh;
+	entry.size = *size;
+
+	this->next = (this->next + 1) % capacity;
+
+	if (this->count < capacity) {
+		this->count++;
+	}
+}
+
+}
@@ -0,0 +1,42 @@
+#ifndef DisplayNodeMeasureCache_h
+#define DisplayNodeMeasureCache_h
+
+#include "DisplayBase.h"
+
+namespace Dezel {
+
+class DisplayNodeMeasureCache {
+
+private:
+
+	struct Entry {
+		double w;
+		double h;
+		double minw;
+		double maxw;
+		double minh;
+		double maxh;
+		MeasuredSize size;
+	};
+
+	static const size_t capacity = 4;
+
+	Entry entries[capacity];
+
+	size_t count = 0;
+	size_t next = 0;
+
+public:
+
+	bool find(MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh) const;
+	void store(const MeasuredSize* size, double w, double h, double minw, double maxw, double minh, double maxh);
+
+	void clear() {
+		this->count = 0;
+		this->next = 0;
+	}
+};
+
+}
+
+#endif
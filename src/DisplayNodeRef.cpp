@@ -2,8 +2,12 @@
 #include "Display.h"
 #include "DisplayNode.h"
 
+using std::vector;
+
 using Dezel::Display;
 using Dezel::DisplayNode;
+using Dezel::Style::Atom;
+using Dezel::Style::Atoms;
 
 DisplayNodeRef
 DisplayNodeCreate()
@@ -29,6 +33,18 @@ DisplayNodeSetOpaque(DisplayNodeRef node)
 	reinterpret_cast<DisplayNode*>(node)->setOpaque();
 }
 
+void
+DisplayNodeSetLayoutBoundary(DisplayNodeRef node, bool layoutBoundary)
+{
+	reinterpret_cast<DisplayNode*>(node)->setLayoutBoundary(layoutBoundary);
+}
+
+void
+DisplayNodeSetThreadSafe(DisplayNodeRef node, bool threadSafe)
+{
+	reinterpret_cast<DisplayNode*>(node)->setThreadSafe(threadSafe);
+}
+
 void
 DisplayNodeSetName(DisplayNodeRef node, const char* name)
 {
@@ -77,6 +93,34 @@ DisplayNodeHasState(DisplayNodeRef node, const char* state)
 	return reinterpret_cast<DisplayNode*>(node)->hasState(std::string(state));
 }
 
+void
+DisplayNodeSetStyles(DisplayNodeRef node, const char** styles, size_t count)
+{
+	vector<Atom> atoms;
+
+	atoms.reserve(count);
+
+	for (size_t i = 0; i < count; i++) {
+		atoms.push_back(Atoms::intern(styles[i]));
+	}
+
+	reinterpret_cast<DisplayNode*>(node)->setStyles(atoms);
+}
+
+void
+DisplayNodeSetStates(DisplayNodeRef node, const char** states, size_t count)
+{
+	vector<Atom> atoms;
+
+	atoms.reserve(count);
+
+	for (size_t i = 0; i < count; i++) {
+		atoms.push_back(Atoms::intern(states[i]));
+	}
+
+	reinterpret_cast<DisplayNode*>(node)->setStates(atoms);
+}
+
 void
 DisplayNodeSetAnchorTop(DisplayNodeRef node, AnchorType type, AnchorUnit unit, double length)
 {
@@ -203,6 +247,24 @@ DisplayNodeSetContentDirection(DisplayNodeRef node, ContentDirection direction)
 	reinterpret_cast<DisplayNode*>(node)->setContentDirection(direction);
 }
 
+void
+DisplayNodeSetContentWrap(DisplayNodeRef node, ContentWrap wrap)
+{
+	reinterpret_cast<DisplayNode*>(node)->setContentWrap(wrap);
+}
+
+void
+DisplayNodeSetEstimatedItemExtent(DisplayNodeRef node, double extent)
+{
+	reinterpret_cast<DisplayNode*>(node)->setEstimatedItemExtent(extent);
+}
+
+void
+DisplayNodeSetItemOverscan(DisplayNodeRef node, double overscan)
+{
+	reinterpret_cast<DisplayNode*>(node)->setItemOverscan(overscan);
+}
+
 void
 DisplayNodeSetContentAlignment(DisplayNodeRef node, ContentAlignment alignment)
 {
@@ -575,6 +637,12 @@ DisplayNodeGetMeasuredPaddingBottom(DisplayNodeRef node)
 	return reinterpret_cast<DisplayNode*>(node)->getMeasuredPaddingBottom();
 }
 
+size_t
+DisplayNodeGetMemoryUsage(DisplayNodeRef node)
+{
+	return reinterpret_cast<DisplayNode*>(node)->getMemoryUsage();
+}
+
 void
 DisplayNodeSetVisible(DisplayNodeRef node, bool visible)
 {
@@ -602,7 +670,12 @@ DisplayNodeRemoveChild(DisplayNodeRef node, DisplayNodeRef child)
 void
 DisplayNodeInvalidateSize(DisplayNodeRef node)
 {
-	reinterpret_cast<DisplayNode*>(node)->invalidateSize();
+	/*
+	 * Hosts invalidate the size when the content of a node changes, the
+	 * measures cached for the previous content are dropped as well.
+	 */
+
+	reinterpret_cast<DisplayNode*>(node)->invalidateMeasure();
 }
 
 void
@@ -617,6 +690,12 @@ DisplayNodeInvalidateLayout(DisplayNodeRef node)
 	reinterpret_cast<DisplayNode*>(node)->invalidateLayout();
 }
 
+void
+DisplayNodeInvalidateMeasure(DisplayNodeRef node)
+{
+	reinterpret_cast<DisplayNode*>(node)->invalidateMeasure();
+}
+
 void
 DisplayNodeResolve(DisplayNodeRef node)
 {
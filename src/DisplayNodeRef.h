@@ -36,6 +36,20 @@ void DisplayNodeSetDisplay(DisplayNodeRef node, DisplayRef display);
  */
 void DisplayNodeSetOpaque(DisplayNodeRef node);
 
+/**
+ * @function DisplayNodeSetLayoutBoundary
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetLayoutBoundary(DisplayNodeRef node, bool layoutBoundary);
+
+/**
+ * @function DisplayNodeSetThreadSafe
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetThreadSafe(DisplayNodeRef node, bool threadSafe);
+
 /**
  * @function DisplayNodeSetName
  * @since 0.1.0
@@ -92,6 +106,20 @@ void DisplayNodeRemoveState(DisplayNodeRef node, const char* state);
  */
 bool DisplayNodeHasState(DisplayNodeRef node, const char* state);
 
+/**
+ * @function DisplayNodeSetStyles
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetStyles(DisplayNodeRef node, const char** styles, size_t count);
+
+/**
+ * @function DisplayNodeSetStates
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetStates(DisplayNodeRef node, const char** states, size_t count);
+
 /**
  * @function DisplayNodeSetAnchorTop
  * @since 0.1.0
@@ -239,6 +267,27 @@ void DisplayNodeSetMaxHeight(DisplayNodeRef node, double max);
  */
 void DisplayNodeSetContentDirection(DisplayNodeRef node, ContentDirection direction);
 
+/**
+ * @function DisplayNodeSetContentWrap
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetContentWrap(DisplayNodeRef node, ContentWrap wrap);
+
+/**
+ * @function DisplayNodeSetEstimatedItemExtent
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetEstimatedItemExtent(DisplayNodeRef node, double extent);
+
+/**
+ * @function DisplayNodeSetItemOverscan
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeSetItemOverscan(DisplayNodeRef node, double overscan);
+
 /**
  * @function DisplayNodeSetContentAlignment
  * @since 0.1.0
@@ -673,6 +722,13 @@ double DisplayNodeGetMeasuredPaddingRight(DisplayNodeRef node);
  */
 double DisplayNodeGetMeasuredPaddingBottom(DisplayNodeRef node);
 
+/**
+ * @function DisplayNodeGetMemoryUsage
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayNodeGetMemoryUsage(DisplayNodeRef node);
+
 /**
  * @function DisplayNodeSetVisible
  * @since 0.1.0
@@ -722,6 +778,13 @@ void DisplayNodeInvalidateOrigin(DisplayNodeRef node);
  */
 void DisplayNodeInvalidateLayout(DisplayNodeRef node);
 
+/**
+ * @function DisplayNodeInvalidateMeasure
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayNodeInvalidateMeasure(DisplayNodeRef node);
+
 /**
  * @function DisplayNodeResolve
  * @since 0.1.0
@@ -0,0 +1,92 @@
+#include "DisplayNodeStyleCache.h"
+#include "DisplayNode.h"
+
+namespace Dezel {
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+bool
+DisplayNodeStyleCache::shares(DisplayNode* node, DisplayNode* entry)
+{
+	/*
+	 * The entry is checked against its current state, a node resolved
+	 * earlier in the pass could have been moved or given other traits. An
+	 * entry matched ahead of the layout is still waiting for its properties
+	 * to be applied.
+	 */
+
+	if (entry == node ||
+		entry->parent != node->parent) {
+		return false;
+	}
+
+	if (entry->invalidTraits &&
+		entry->pendingProperties == nullptr) {
+		return false;
+	}
+
+	return (
+		entry->name == node->name &&
+		entry->isOpaque() == node->isOpaque() &&
+		entry->isWindow() == node->isWindow() &&
+		entry->types == node->types &&
+		entry->styles == node->styles &&
+		entry->states == node->states
+	);
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+DisplayNodeStyleCache::sync(unsigned version)
+{
+	/*
+	 * An entry only shares its properties with nodes that have the same
+	 * parent and traits, but the rules it matched also depend on the traits
+	 * of its ancestors. The cache is emptied when any of them changed.
+	 */
+
+	if (this->version != version) {
+		this->version = version;
+		this->clear();
+	}
+}
+
+const Style::PropertyList*
+DisplayNodeStyleCache::find(DisplayNode* node) const
+{
+	if (node->parent == nullptr) {
+		return nullptr;
+	}
+
+	for (auto entry : this->entries) {
+		if (entry && shares(node, entry)) {
+			return entry->invalidTraits ? entry->pendingProperties : entry->properties;
+		}
+	}
+
+	return nullptr;
+}
+
+void
+DisplayNodeStyleCache::store(DisplayNode* node)
+{
+	this->entries[this->next] = node;
+	this->next = (this->next + 1) % capacity;
+}
+
+void
+DisplayNodeStyleCache::clear()
+{
+	for (auto& entry : this->entries) {
+		entry = nullptr;
+	}
+
+	this->next = 0;
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef DisplayNodeStyleCache_h
+#define DisplayNodeStyleCache_h
+
+#include <stddef.h>
+
+namespace Dezel {
+
+namespace Style {
+	class PropertyList;
+}
+
+class DisplayNode;
+
+class DisplayNodeStyleCache {
+
+private:
+
+	/*
+	 * The cache holds the nodes which traits were matched most recently.
+	 * A node can share the properties of one of them when both have the
+	 * same parent and the same traits since they match the same rules.
+	 */
+
+	static const size_t capacity = 8;
+
+	DisplayNode* entries[capacity] = {};
+
+	size_t next = 0;
+
+	unsigned version = 0;
+
+	static bool shares(DisplayNode* node, DisplayNode* entry);
+
+public:
+
+	void sync(unsigned version);
+
+	const Style::PropertyList* find(DisplayNode* node) const;
+
+	void store(DisplayNode* node);
+
+	void clear();
+
+};
+
+}
+
+#endif
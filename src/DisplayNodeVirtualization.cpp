@@ -0,0 +1,46 @@
+#include "DisplayNodeVirtualization.h"
+
+namespace Dezel {
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+double
+DisplayNodeVirtualization::getExtent(size_t index) const
+{
+	if (index < this->extents.size() &&
+		this->extents[index] >= 0) {
+		return this->extents[index];
+	}
+
+	return this->estimate;
+}
+
+void
+DisplayNodeVirtualization::setExtent(size_t index, double extent)
+{
+	if (index >= this->extents.size()) {
+		this->extents.resize(index + 1, -1);
+	}
+
+	this->extents[index] = static_cast<float>(extent);
+}
+
+void
+DisplayNodeVirtualization::insert(size_t index)
+{
+	if (index < this->extents.size()) {
+		this->extents.insert(this->extents.begin() + index, -1);
+	}
+}
+
+void
+DisplayNodeVirtualization::remove(size_t index)
+{
+	if (index < this->extents.size()) {
+		this->extents.erase(this->extents.begin() + index);
+	}
+}
+
+}
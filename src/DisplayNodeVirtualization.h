@@ -0,0 +1,42 @@
+#ifndef DisplayNodeVirtualization_h
+#define DisplayNodeVirtualization_h
+
+#include <cstddef>
+#include <vector>
+
+namespace Dezel {
+
+using std::size_t;
+using std::vector;
+
+class DisplayNodeVirtualization {
+
+private:
+
+	/*
+	 * The extents are stored as floats, one per child, to keep the array
+	 * compact on containers with thousands of children. A negative value
+	 * means the child has not been measured yet.
+	 */
+
+	vector<float> extents;
+
+public:
+
+	double estimate = 0;
+	double overscan = 0;
+
+	double getExtent(size_t index) const;
+	void setExtent(size_t index, double extent);
+
+	void insert(size_t index);
+	void remove(size_t index);
+
+	size_t getMemoryUsage() const {
+		return sizeof(DisplayNodeVirtualization) + this->extents.capacity() * sizeof(float);
+	}
+};
+
+}
+
+#endif
@@ -3,33 +3,98 @@
 
 namespace Dezel {
 
-DisplayNodeWalker::DisplayNodeWalker(DisplayNode* root)
+DisplayNodeWalker::DisplayNodeWalker(DisplayNode* root, DisplayNodeWalkerOrder order)
 {
-	this->queue.push(root);
+	this->reset(root, order);
+}
+
+void
+DisplayNodeWalker::reset(DisplayNode* root, DisplayNodeWalkerOrder order)
+{
+	/*
+	 * Clearing the stack keeps its capacity, a walker that is reused does
+	 * not allocate once it has been through the deepest branch.
+	 */
+
+	this->frames.clear();
+	this->order = order;
+	this->node = nullptr;
+
+	if (root == nullptr) {
+		return;
+	}
+
+	switch (order) {
+
+		case kDisplayNodeWalkerOrderPre:
+			this->node = root;
+			break;
+
+		case kDisplayNodeWalkerOrderPost:
+			this->enter(root);
+			break;
+	}
 }
 
 bool
 DisplayNodeWalker::hasNext()
 {
-	if (this->queue.size() == 0) {
-		return false;
+	if (this->node) {
+		return true;
 	}
 
-	this->consume();
+	while (this->frames.size()) {
+
+		auto child = this->nextChild();
+
+		if (child) {
+
+			if (this->order == kDisplayNodeWalkerOrderPre) {
+				this->node = child;
+				return true;
+			}
 
-	return true;
+			this->enter(child);
+
+			continue;
+		}
+
+		if (this->order == kDisplayNodeWalkerOrderPost) {
+			this->node = this->frames.back().node;
+			this->frames.pop_back();
+			return true;
+		}
+
+		this->frames.pop_back();
+	}
+
+	return false;
 }
 
 void
-DisplayNodeWalker::getNext() {
+DisplayNodeWalker::getNext()
+{
+	if (this->node == nullptr) {
+		return;
+	}
 
-	this->dequeue();
+	if (this->order == kDisplayNodeWalkerOrderPre) {
+		this->enter(this->node);
+	}
 
-	auto children = this->node->getChildren();
+	this->node = nullptr;
+}
 
-	for (auto child : children) if (child->isVisible()) {
-		this->enqueue(child);
-	}
+void
+DisplayNodeWalker::skipChildren()
+{
+	/*
+	 * Moves past the current node without visiting its children. This
+	 * only prunes the walk in pre-order since children have already been
+	 * visited in post-order.
+	 */
+
+	this->node = nullptr;
 }
 
 }
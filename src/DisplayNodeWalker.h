@@ -1,45 +1,140 @@
 #ifndef DisplayWalker_h
 #define DisplayWalker_h
 
-#include <queue>
+#include "DisplayNode.h"
+
+#include <vector>
 
 namespace Dezel {
 
-using std::queue;
+using std::vector;
 
 class Display;
 class DisplayNode;
 
+typedef enum {
+	kDisplayNodeWalkerOrderPre = 1,
+	kDisplayNodeWalkerOrderPost = 2
+} DisplayNodeWalkerOrder;
+
 class DisplayNodeWalker {
 
 private:
 
-	queue<DisplayNode*> queue;
+	struct Frame {
+		DisplayNode* node;
+		size_t index;
+	};
 
-	DisplayNode* node;
+	vector<Frame> frames;
 
-	void consume() {
-		this->node = this->queue.front();
-	}
+	DisplayNodeWalkerOrder order = kDisplayNodeWalkerOrderPre;
+
+	DisplayNode* node = nullptr;
 
-	void dequeue() {
-		this->queue.pop();
+	bool walking = false;
+
+	void enter(DisplayNode* node) {
+		this->frames.push_back({node, 0});
 	}
 
-	void enqueue(DisplayNode* node) {
-		this->queue.push(node);
+	DisplayNode* nextChild() {
+
+		/*
+		 * Returns the next visible child of the node at the top of the
+		 * stack. Children are accessed by index so the walk remains valid
+		 * if the children vector is reallocated by a callback.
+		 */
+
+		auto& frame = this->frames.back();
+		auto& children = frame.node->getChildren();
+
+		while (frame.index < children.size()) {
+
+			auto child = children[frame.index++];
+
+			if (child->isVisible()) {
+				return child;
+			}
+		}
+
+		return nullptr;
 	}
 
 public:
 
-	DisplayNodeWalker(DisplayNode* root);
+	DisplayNodeWalker() {}
+	DisplayNodeWalker(DisplayNode* root, DisplayNodeWalkerOrder order = kDisplayNodeWalkerOrderPre);
 
 	DisplayNode* getNode() const {
 		return this->node;
 	}
 
+	void reset(DisplayNode* root, DisplayNodeWalkerOrder order = kDisplayNodeWalkerOrderPre);
+
 	bool hasNext();
 	void getNext();
+	void skipChildren();
+
+	/**
+	 * Walks the visible subtree of the root in pre-order. The children of
+	 * a node are only visited when the enter function returns true and
+	 * the leave function is invoked in post-order for every entered node.
+	 * A walk started from a callback while this walker is already walking
+	 * uses a stack of its own and leaves the current walk untouched.
+	 */
+	template <typename Enter, typename Leave>
+	void visit(DisplayNode* root, Enter&& enter, Leave&& leave) {
+
+		if (this->walking) {
+			DisplayNodeWalker nested;
+			nested.visit(root, enter, leave);
+			return;
+		}
+
+		this->frames.clear();
+
+		if (root == nullptr ||
+			enter(root) == false) {
+			return;
+		}
+
+		this->walking = true;
+
+		this->enter(root);
+
+		while (this->frames.size()) {
+
+			auto child = this->nextChild();
+
+			if (child) {
+
+				if (enter(child)) {
+					this->enter(child);
+				}
+
+				continue;
+			}
+
+			auto node = this->frames.back().node;
+
+			this->frames.pop_back();
+
+			leave(node);
+		}
+
+		this->walking = false;
+	}
+
+	template <typename Enter>
+	void visit(DisplayNode* root, Enter&& enter) {
+		this->visit(root, enter, [](DisplayNode*) {});
+	}
+
+	template <typename Leave>
+	void visitPostOrder(DisplayNode* root, Leave&& leave) {
+		this->visit(root, [](DisplayNode*) { return true; }, leave);
+	}
 
 };
 
@@ -24,6 +24,18 @@ DisplaySetStylesheet(DisplayRef display, StylesheetRef stylesheet)
 	reinterpret_cast<Display*>(display)->setStylesheet(reinterpret_cast<Stylesheet*>(stylesheet));
 }
 
+void
+DisplaySetLayoutThreads(DisplayRef display, size_t threads)
+{
+	reinterpret_cast<Display*>(display)->setLayoutThreads(threads);
+}
+
+void
+DisplaySetNativeLayoutProperties(DisplayRef display, bool native)
+{
+	reinterpret_cast<Display*>(display)->setNativeLayoutProperties(native);
+}
+
 void
 DisplaySetWindow(DisplayRef display, DisplayNodeRef window)
 {
@@ -60,6 +72,12 @@ DisplaySetResolveCallback(DisplayRef display, DisplayCallback callback)
 	reinterpret_cast<Display*>(display)->setResolveCallback(callback);
 }
 
+void
+DisplaySetEventsCallback(DisplayRef display, DisplayEventsCallback callback)
+{
+	reinterpret_cast<Display*>(display)->setEventsCallback(callback);
+}
+
 void
 DisplaySetData(DisplayRef display, void *data)
 {
@@ -84,6 +102,48 @@ DisplayIsResolving(DisplayRef display)
 	return reinterpret_cast<Display*>(display)->isResolving();
 }
 
+size_t
+DisplayGetMeasureCacheHits(DisplayRef display)
+{
+	return reinterpret_cast<Display*>(display)->getMeasureCacheHits();
+}
+
+size_t
+DisplayGetMeasureCacheMisses(DisplayRef display)
+{
+	return reinterpret_cast<Display*>(display)->getMeasureCacheMisses();
+}
+
+size_t
+DisplayGetStyleCacheHits(DisplayRef display)
+{
+	return reinterpret_cast<Display*>(display)->getStyleCacheHits();
+}
+
+size_t
+DisplayGetStyleCacheMisses(DisplayRef display)
+{
+	return reinterpret_cast<Display*>(display)->getStyleCacheMisses();
+}
+
+size_t
+DisplayGetChangedFrames(DisplayRef display, DisplayNodeFrame* buffer, size_t capacity)
+{
+	return reinterpret_cast<Display*>(display)->getChangedFrames(buffer, capacity);
+}
+
+void
+DisplayBeginTraitBatch(DisplayRef display)
+{
+	reinterpret_cast<Display*>(display)->beginTraitBatch();
+}
+
+void
+DisplayEndTraitBatch(DisplayRef display)
+{
+	reinterpret_cast<Display*>(display)->endTraitBatch();
+}
+
 void
 DisplayResolve(DisplayRef display)
 {
@@ -28,6 +28,20 @@ void DisplayDelete(DisplayRef display);
  */
 void DisplaySetStylesheet(DisplayRef display, StylesheetRef stylesheet);
 
+/**
+ * @function DisplaySetLayoutThreads
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplaySetLayoutThreads(DisplayRef display, size_t threads);
+
+/**
+ * @function DisplaySetNativeLayoutProperties
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplaySetNativeLayoutProperties(DisplayRef display, bool native);
+
 /**
  * @function DisplaySetWindow
  * @since 0.1.0
@@ -70,6 +84,13 @@ void DisplaySetPrepareCallback(DisplayRef display, DisplayCallback callback);
  */
 void DisplaySetResolveCallback(DisplayRef display, DisplayCallback callback);
 
+/**
+ * @function DisplaySetEventsCallback
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplaySetEventsCallback(DisplayRef display, DisplayEventsCallback callback);
+
 /**
  * @function DisplaySetData
  * @since 0.1.0
@@ -98,6 +119,55 @@ bool DisplayIsInvalid(DisplayRef display);
  */
 bool DisplayIsResolving(DisplayRef display);
 
+/**
+ * @function DisplayGetMeasureCacheHits
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayGetMeasureCacheHits(DisplayRef display);
+
+/**
+ * @function DisplayGetMeasureCacheMisses
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayGetMeasureCacheMisses(DisplayRef display);
+
+/**
+ * @function DisplayGetStyleCacheHits
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayGetStyleCacheHits(DisplayRef display);
+
+/**
+ * @function DisplayGetStyleCacheMisses
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayGetStyleCacheMisses(DisplayRef display);
+
+/**
+ * @function DisplayGetChangedFrames
+ * @since 0.1.0
+ * @hidden
+ */
+size_t DisplayGetChangedFrames(DisplayRef display, DisplayNodeFrame* buffer, size_t capacity);
+
+/**
+ * @function DisplayBeginTraitBatch
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayBeginTraitBatch(DisplayRef display);
+
+/**
+ * @function DisplayEndTraitBatch
+ * @since 0.1.0
+ * @hidden
+ */
+void DisplayEndTraitBatch(DisplayRef display);
+
 /**
  * @function DisplayResolve
  * @since 0.1.0
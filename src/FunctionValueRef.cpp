@@ -27,6 +27,6 @@ FunctionValueGetArgumentValues(FunctionValueRef function, size_t index)
 	auto values = &reinterpret_cast<FunctionValue*>(function)->getArguments().at(index)->getValues();
 
 	return reinterpret_cast<ValueListRef>(
-		const_cast<vector<Value*>*>(values)
+		const_cast<vector<Value>*>(values)
 	);
 }
@@ -1,9 +1,6 @@
 #include "PropertyRef.h"
 #include "Property.h"
 #include "Value.h"
-#include "StringValue.h"
-#include "NumberValue.h"
-#include "BooleanValue.h"
 
 #include <string>
 #include <vector>
@@ -13,9 +10,6 @@ using std::vector;
 
 using Dezel::Style::Property;
 using Dezel::Style::Value;
-using Dezel::Style::StringValue;
-using Dezel::Style::NumberValue;
-using Dezel::Style::BooleanValue;
 
 const char*
 PropertyGetName(PropertyRef property)
@@ -27,7 +21,7 @@ ValueListRef
 PropertyGetValues(PropertyRef property)
 {
 	return reinterpret_cast<ValueListRef>(
-		const_cast<vector<Value*>*>(&reinterpret_cast<Property*>(property)->getValues())
+		const_cast<vector<Value>*>(&reinterpret_cast<Property*>(property)->getValues())
 	);
 }
 
@@ -24,7 +24,7 @@ StylesheetCreate()
 void
 StylesheetDelete(StylesheetRef stylesheet)
 {
-	delete reinterpret_cast<Stylesheet*>(stylesheet);
+	reinterpret_cast<Stylesheet*>(stylesheet)->release();
 }
 
 void
@@ -79,4 +79,8 @@ StylesheetEvaluate(StylesheetRef stylesheet, const char* source, const char* url
 	}
 }
 
-
+size_t
+StylesheetGetMemoryUsage(StylesheetRef stylesheet)
+{
+	return reinterpret_cast<Stylesheet*>(stylesheet)->getMemoryUsage();
+}
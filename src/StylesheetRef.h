@@ -35,6 +35,13 @@ void StylesheetSetVariable(StylesheetRef stylesheet, const char* name, const cha
  */
 void StylesheetEvaluate(StylesheetRef stylesheet, const char* source, const char* url, ParseError** error);
 
+/**
+ * @function StylesheetGetMemoryUsage
+ * @since 0.1.0
+ * @hidden
+ */
+size_t StylesheetGetMemoryUsage(StylesheetRef stylesheet);
+
 #if __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 #include "ValueListRef.h"
 #include "Value.h"
+#include "FunctionValue.h"
+#include "VariableValue.h"
 
 #include <string>
 #include <vector>
@@ -8,14 +10,43 @@ using std::string;
 using std::vector;
 
 using Dezel::Style::Value;
+using Dezel::Style::FunctionValue;
+using Dezel::Style::VariableValue;
+
+static void release(const Value& value)
+{
+	/*
+	 * Values parsed on their own are not part of a stylesheet arena, the
+	 * text of the strings and the functions and variables that could not
+	 * be evaluated are released with the list.
+	 */
+
+	if (value.getType() == kValueTypeString) {
+		delete[] value.getString();
+	}
+
+	if (value.getType() == kValueTypeFunction) {
+
+		for (auto argument : value.getFunction()->getArguments()) {
+			for (auto& value : argument->getValues()) release(value);
+			delete argument;
+		}
+
+		delete value.getFunction();
+	}
+
+	if (value.getType() == kValueTypeVariable) {
+		delete value.getVariable();
+	}
+}
 
 void
 ValueListDelete(ValueListRef values)
 {
-	auto items = reinterpret_cast<vector<Value*>*>(values);
+	auto items = reinterpret_cast<vector<Value>*>(values);
 
-	for (auto value : *items) {
-		delete value;
+	for (auto& value : *items) {
+		release(value);
 	}
 
 	delete items;
@@ -24,13 +55,13 @@ ValueListDelete(ValueListRef values)
 size_t
 ValueListGetCount(ValueListRef values)
 {
-	return reinterpret_cast<vector<Value*>*>(values)->size();
+	return reinterpret_cast<vector<Value>*>(values)->size();
 }
 
 ValueRef
 ValueListGetValue(ValueListRef values, size_t index)
 {
 	return reinterpret_cast<ValueRef>(
-		reinterpret_cast<vector<Value*>*>(values)->at(index)
+		&reinterpret_cast<vector<Value>*>(values)->at(index)
 	);
 }
@@ -1,8 +1,6 @@
 #include "ValueRef.h"
+#include "ValueListRef.h"
 #include "Value.h"
-#include "StringValue.h"
-#include "NumberValue.h"
-#include "BooleanValue.h"
 #include "Parser.h"
 #include "ParseException.h"
 
@@ -13,21 +11,18 @@ using std::string;
 using std::vector;
 
 using Dezel::Style::Value;
-using Dezel::Style::StringValue;
-using Dezel::Style::NumberValue;
-using Dezel::Style::BooleanValue;
 using Dezel::Style::Parser;
 using Dezel::Style::ParseException;
 
 ValueListRef
 ValueParse(const char* source)
 {
-	auto values = new vector<Value*>();
+	auto values = new vector<Value>();
 
 	try {
 		Parser::parse(*values, string(source));
 	} catch (ParseException& e) {
-		delete values;
+		ValueListDelete(reinterpret_cast<ValueListRef>(values));
 		return nullptr;
 	}
 
@@ -56,35 +51,39 @@ ValueGetUnit(ValueRef value)
 const char*
 ValueGetString(ValueRef value)
 {
-	return reinterpret_cast<StringValue*>(
-		reinterpret_cast<Value*>(value)
-	)->getValue().c_str();
+	auto item = reinterpret_cast<Value*>(value);
+
+	if (item->getType() != kValueTypeString) {
+		return "";
+	}
+
+	return item->getString();
 }
 
 double
 ValueGetNumber(ValueRef value)
 {
-	return reinterpret_cast<NumberValue*>(
-		reinterpret_cast<Value*>(value)
-	)->getValue();
+	return reinterpret_cast<Value*>(value)->getNumber();
 }
 
 bool
 ValueGetBoolean(ValueRef value)
 {
-	return reinterpret_cast<BooleanValue*>(
-		reinterpret_cast<Value*>(value)
-	)->getValue();
+	return reinterpret_cast<Value*>(value)->getBoolean();
 }
 
 VariableValueRef
 ValueGetVariable(ValueRef value)
 {
-	return reinterpret_cast<VariableValueRef>(value);
+	return reinterpret_cast<VariableValueRef>(
+		reinterpret_cast<Value*>(value)->getVariable()
+	);
 }
 
 FunctionValueRef
 ValueGetFunction(ValueRef value)
 {
-	return reinterpret_cast<FunctionValueRef>(value);
+	return reinterpret_cast<FunctionValueRef>(
+		reinterpret_cast<Value*>(value)->getFunction()
+	);
 }
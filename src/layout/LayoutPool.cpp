@@ -0,0 +1,244 @@
+#include "LayoutPool.h"
+
+namespace Dezel {
+namespace Layout {
+
+using std::unique_lock;
+using std::lock_guard;
+using std::current_exception;
+using std::rethrow_exception;
+
+/*
+ * Index of the queue owned by the current thread. The thread that owns the
+ * pool, usually the main thread, uses the last queue.
+ */
+
+static thread_local size_t current = static_cast<size_t>(-1);
+
+LayoutPool::LayoutPool(size_t count)
+{
+	/*
+	 * The thread waiting on a group also executes jobs, so one less worker
+	 * is needed to use the requested amount of threads.
+	 */
+
+	for (size_t i = 0; i < count; i++) {
+		this->queues.push_back(new Queue());
+	}
+
+	for (size_t i = 0; i + 1 < count; i++) {
+		this->threads.push_back(thread(&LayoutPool::work, this, i));
+	}
+}
+
+LayoutPool::~LayoutPool()
+{
+	{
+		lock_guard<mutex> guard(this->lock);
+		this->stopping = true;
+	}
+
+	this->condition.notify_all();
+
+	for (auto& thread : this->threads) {
+		thread.join();
+	}
+
+	for (auto queue : this->queues) {
+		delete queue;
+	}
+}
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+LayoutPool::Job*
+LayoutPool::take(size_t index)
+{
+	auto queue = this->queues[index];
+
+	lock_guard<mutex> guard(queue->lock);
+
+	if (queue->jobs.empty()) {
+		return nullptr;
+	}
+
+	auto job = queue->jobs.back();
+	queue->jobs.pop_back();
+	this->queued--;
+	return job;
+}
+
+LayoutPool::Job*
+LayoutPool::steal(size_t index)
+{
+	/*
+	 * A thread first runs the jobs it submitted itself, newest first, then
+	 * takes the oldest jobs of the other queues which are usually the
+	 * largest subtrees.
+	 */
+
+	auto job = this->take(index);
+
+	if (job) {
+		return job;
+	}
+
+	const auto count = this->queues.size();
+
+	for (size_t i = 1; i < count; i++) {
+
+		auto queue = this->queues[(index + i) % count];
+
+		lock_guard<mutex> guard(queue->lock);
+
+		if (queue->jobs.empty()) {
+			continue;
+		}
+
+		job = queue->jobs.front();
+		queue->jobs.pop_front();
+		this->queued--;
+		return job;
+	}
+
+	return nullptr;
+}
+
+void
+LayoutPool::execute(Job* job)
+{
+	/*
+	 * A job that throws still completes its group, otherwise the thread
+	 * waiting on it would never return. The first exception is kept and
+	 * thrown again by that thread.
+	 */
+
+	auto group = job->group;
+
+	try {
+
+		job->run();
+
+	} catch (...) {
+
+		lock_guard<mutex> guard(this->lock);
+
+		if (group->exception == nullptr) {
+			group->exception = current_exception();
+		}
+	}
+
+	delete job;
+
+	{
+		lock_guard<mutex> guard(this->lock);
+		group->pending--;
+	}
+
+	this->finished.notify_all();
+}
+
+void
+LayoutPool::work(size_t index)
+{
+	current = index;
+
+	while (true) {
+
+		auto job = this->steal(index);
+
+		if (job) {
+			this->execute(job);
+			continue;
+		}
+
+		unique_lock<mutex> guard(this->lock);
+
+		this->condition.wait(guard, [this] {
+			return this->stopping || this->queued > 0;
+		});
+
+		if (this->stopping) {
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+LayoutPool::submit(LayoutGroup& group, function<void()> run)
+{
+	auto index = current;
+
+	if (index >= this->queues.size()) {
+		index = this->queues.size() - 1;
+	}
+
+	auto queue = this->queues[index];
+
+	group.pending++;
+
+	{
+		lock_guard<mutex> guard(queue->lock);
+		queue->jobs.push_back(new Job{run, &group});
+		this->queued++;
+	}
+
+	{
+		lock_guard<mutex> guard(this->lock);
+	}
+
+	this->condition.notify_one();
+	this->finished.notify_all();
+}
+
+void
+LayoutPool::wait(LayoutGroup& group)
+{
+	auto index = current;
+
+	if (index >= this->queues.size()) {
+		index = this->queues.size() - 1;
+	}
+
+	/*
+	 * The waiting thread executes pending jobs until every job of the group
+	 * has completed. This allows jobs to submit and wait on nested groups
+	 * without starving the pool. It only blocks when there is nothing left
+	 * to take and is woken up by a completion or a submission.
+	 */
+
+	while (true) {
+
+		auto job = this->steal(index);
+
+		if (job) {
+			this->execute(job);
+			continue;
+		}
+
+		unique_lock<mutex> guard(this->lock);
+
+		this->finished.wait(guard, [this, &group] {
+			return group.pending == 0 || this->queued > 0;
+		});
+
+		if (group.pending == 0) {
+			break;
+		}
+	}
+
+	if (group.exception) {
+		auto exception = group.exception;
+		group.exception = nullptr;
+		rethrow_exception(exception);
+	}
+}
+
+}
+}
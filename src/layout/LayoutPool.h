@@ -0,0 +1,91 @@
+#ifndef LayoutPool_h
+#define LayoutPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Dezel {
+namespace Layout {
+
+using std::atomic;
+using std::condition_variable;
+using std::deque;
+using std::exception_ptr;
+using std::function;
+using std::mutex;
+using std::thread;
+using std::vector;
+
+class LayoutPool;
+
+class LayoutGroup {
+
+private:
+
+	atomic<size_t> pending{0};
+
+	exception_ptr exception = nullptr;
+
+public:
+
+	friend class LayoutPool;
+
+};
+
+class LayoutPool {
+
+private:
+
+	struct Job {
+		function<void()> run;
+		LayoutGroup* group;
+	};
+
+	struct Queue {
+		deque<Job*> jobs;
+		mutex lock;
+	};
+
+	vector<thread> threads;
+	vector<Queue*> queues;
+
+	mutex lock;
+	condition_variable condition;
+	condition_variable finished;
+
+	atomic<size_t> queued{0};
+	atomic<size_t> submitted{0};
+
+	bool stopping = false;
+
+	Job* take(size_t index);
+	Job* steal(size_t index);
+
+	void execute(Job* job);
+	void work(size_t index);
+
+public:
+
+	LayoutPool(size_t count);
+
+	~LayoutPool();
+
+	size_t getThreadCount() const {
+		return this->threads.size() + 1;
+	}
+
+	void submit(LayoutGroup& group, function<void()> run);
+	void wait(LayoutGroup& group);
+
+};
+
+}
+}
+
+#endif
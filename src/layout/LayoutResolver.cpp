@@ -38,12 +38,23 @@ LayoutResolver::resolve() {
 		return;
 	}
 
+	const bool virtualized = this->node->isVirtualized();
+
 	for (auto child : this->node->children) {
 
 		if (child->visible == false) {
 			continue;
 		}
 
+		/*
+		 * The relative children of a virtualized node are resolved by the
+		 * relative layout once it knows which of them are in view.
+		 */
+
+		if (virtualized && child->isRelative()) {
+			continue;
+		}
+
 		child->resolveTraits();
 
 		child->inheritedWrappedContentWidth = child->inheritsWrappedWidth();
@@ -8,7 +8,6 @@
 
 namespace Dezel {
 	class DisplayNode;
-	class DisplayNodeFrame;
 }
 
 namespace Dezel {
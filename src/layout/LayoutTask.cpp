@@ -0,0 +1,32 @@
+#include "LayoutTask.h"
+
+namespace Dezel {
+namespace Layout {
+
+thread_local LayoutTask* LayoutTask::current = nullptr;
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+LayoutTask*
+LayoutTask::enter()
+{
+	auto previous = current;
+	current = this;
+	return previous;
+}
+
+void
+LayoutTask::leave(LayoutTask* previous)
+{
+	/*
+	 * A thread waiting on a group executes other jobs meanwhile, the task it
+	 * was running before must be restored once this one is done.
+	 */
+
+	current = previous;
+}
+
+}
+}
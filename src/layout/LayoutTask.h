@@ -0,0 +1,97 @@
+#ifndef LayoutTask_h
+#define LayoutTask_h
+
+#include "DisplayBase.h"
+#include "DisplayNodeWalker.h"
+#include "DisplayNodeStyleCache.h"
+#include "AncestorFilter.h"
+#include "PropertyList.h"
+
+#include <vector>
+#include <utility>
+
+namespace Dezel {
+	class Display;
+	class DisplayNode;
+}
+
+namespace Dezel {
+namespace Layout {
+
+using std::vector;
+using std::pair;
+
+class LayoutTask {
+
+private:
+
+	DisplayNode* root;
+
+	DisplayNodeWalker walker;
+	DisplayNodeWalker traitsWalker;
+
+	Style::AncestorFilter filter;
+
+	DisplayNodeStyleCache styleCache;
+
+	Style::PropertyDiff propertyDiff;
+
+	vector<DisplayNode*> resolved;
+	vector<DisplayNode*> escaped;
+	vector<DisplayNode*> journal;
+	vector<pair<DisplayNode*, DisplayNodeCallback>> events;
+
+	size_t measureCacheHits = 0;
+	size_t measureCacheMisses = 0;
+	size_t styleCacheHits = 0;
+	size_t styleCacheMisses = 0;
+
+	static thread_local LayoutTask* current;
+
+public:
+
+	friend class Dezel::Display;
+	friend class Dezel::DisplayNode;
+
+	LayoutTask(DisplayNode* root) : root(root) {}
+
+	/**
+	 * Returns the task being resolved on the current thread, or null when
+	 * the nodes are resolved by the display itself.
+	 */
+	static LayoutTask* getCurrent() {
+		return current;
+	}
+
+	DisplayNode* getRoot() const {
+		return this->root;
+	}
+
+	LayoutTask* enter();
+	void leave(LayoutTask* previous);
+
+	/**
+	 * Runs the work with this task as the current one. The previous task
+	 * is restored even when the work throws.
+	 */
+	template <typename Work>
+	void run(Work&& work) {
+
+		auto previous = this->enter();
+
+		try {
+			work();
+		} catch (...) {
+			this->leave(previous);
+			throw;
+		}
+
+		this->leave(previous);
+	}
+
+};
+
+}
+}
+
+#endif
@@ -301,6 +301,399 @@ RelativeLayoutResolver::shrinkNodesHorizontally(const vector<DisplayNode*> &node
 	}
 }
 
+void
+RelativeLayoutResolver::position(DisplayNode* child, double x, double y)
+{
+	const double anchorTop = child->measureAnchorTop();
+	const double anchorLeft = child->measureAnchorLeft();
+
+	const double measuredT = y - anchorTop;
+	const double measuredL = x - anchorLeft;
+	const double measuredR = (child->parent->measuredContentWidth - child->measuredWidth - x) - anchorLeft;
+	const double measuredB = (child->parent->measuredContentHeight - child->measuredHeight - y) - anchorTop;
+
+	if (child->measuredTop != measuredT ||
+		child->measuredLeft != measuredL ||
+		child->measuredRight != measuredR ||
+		child->measuredBottom != measuredB) {
+
+		child->measuredTop = measuredT;
+		child->measuredLeft = measuredL;
+		child->measuredRight = measuredR;
+		child->measuredBottom = measuredB;
+
+		child->didResolveOrigin();
+	}
+
+	this->extentTop = min(this->extentTop, child->measuredTop + child->measuredMarginTop);
+	this->extentLeft = min(this->extentLeft, child->measuredLeft + child->measuredMarginBottom);
+	this->extentRight = max(this->extentRight, child->measuredLeft + child->measuredWidth + child->measuredMarginRight);
+	this->extentBottom = max(this->extentBottom, child->measuredTop + child->measuredHeight + child->measuredMarginBottom);
+
+	child->invalidSize = false;
+	child->invalidOrigin = false;
+
+	child->resolvedSize = true;
+	child->resolvedOrigin = true;
+	child->resolvedParent = this->node;
+
+	child->resolveBorders();
+	child->resolveInnerSize();
+	child->resolveContentSize();
+	child->resolvePadding();
+}
+
+void
+RelativeLayoutResolver::resolveSize(DisplayNode* child)
+{
+	if (child->lastMeasuredWidth != child->measuredWidth ||
+		child->lastMeasuredHeight != child->measuredHeight) {
+		child->lastMeasuredWidth = child->measuredWidth;
+		child->lastMeasuredHeight = child->measuredHeight;
+		child->didResolveSize();
+	}
+}
+
+void
+RelativeLayoutResolver::resolveSizes(const vector<DisplayNode*> &nodes)
+{
+	for (auto child : nodes) {
+		this->resolveSize(child);
+	}
+}
+
+void
+RelativeLayoutResolver::resolveLines()
+{
+	const double scale = this->node->display->getScale();
+
+	const double paddingT = this->node->measuredPaddingTop;
+	const double paddingL = this->node->measuredPaddingLeft;
+	const double paddingR = this->node->measuredPaddingRight;
+	const double paddingB = this->node->measuredPaddingBottom;
+
+	const double contentW = max(this->node->measuredContentWidth - paddingL - paddingR, 0.0);
+	const double contentH = max(this->node->measuredContentHeight - paddingT - paddingB, 0.0);
+	const double contentT = this->node->measuredContentTop + paddingT;
+	const double contentL = this->node->measuredContentLeft + paddingL;
+
+	const bool vertical = this->node->contentDirection == kContentDirectionVertical;
+
+	/*
+	 * A node that wraps its content along the main axis has no space
+	 * to break against, its children are laid out on a single line.
+	 */
+
+	const bool breaks = vertical ? this->node->isWrappingContentHeight() == false : this->node->isWrappingContentWidth() == false;
+
+	const double space = vertical ? contentH : contentW;
+
+	for (auto child : this->nodes) {
+
+		double remainder = 0;
+		double remainingW = contentW;
+		double remainingH = contentH;
+
+		this->measure(
+			child,
+			remainingW,
+			remainingH,
+			remainder
+		);
+	}
+
+	/*
+	 * A line is a range of the children, the ones that expand or shrink
+	 * are gathered in a buffer kept by the resolver so that laying out
+	 * lines does not allocate once the buffer has grown.
+	 */
+
+	const size_t count = this->nodes.size();
+
+	double cross = 0;
+
+	size_t head = 0;
+
+	while (head < count) {
+
+		double used = 0;
+		double lineSize = 0;
+		double expandablesWeight = 0;
+		double shrinkablesWeight = 0;
+
+		size_t tail = head;
+
+		while (tail < count) {
+
+			auto child = this->nodes[tail];
+
+			const double main = vertical
+				? child->measuredHeight + child->measuredMarginTop + child->measuredMarginBottom
+				: child->measuredWidth + child->measuredMarginLeft + child->measuredMarginRight;
+
+			if (breaks && tail > head && used + main > space) {
+				break;
+			}
+
+			const double size = vertical
+				? child->measuredWidth + child->measuredMarginLeft + child->measuredMarginRight
+				: child->measuredHeight + child->measuredMarginTop + child->measuredMarginBottom;
+
+			used += main;
+			lineSize = max(lineSize, size);
+
+			if (child->shrinkFactor > 0) {
+				shrinkablesWeight += child->shrinkFactor;
+			}
+
+			if (child->expandFactor > 0) {
+				expandablesWeight += child->expandFactor;
+			}
+
+			tail++;
+		}
+
+		const size_t length = tail - head;
+
+		double directionSpace = breaks ? space - used : 0;
+
+		if (directionSpace > 0 && expandablesWeight > 0) {
+
+			this->flexibles.clear();
+
+			for (size_t i = head; i < tail; i++) {
+				if (this->nodes[i]->expandFactor > 0) {
+					this->flexibles.push_back(this->nodes[i]);
+				}
+			}
+
+			if (vertical) {
+				this->expandNodesVertically(this->flexibles, directionSpace, expandablesWeight);
+			} else {
+				this->expandNodesHorizontally(this->flexibles, directionSpace, expandablesWeight);
+			}
+
+			directionSpace = 0;
+
+		} else if (directionSpace < 0 && shrinkablesWeight > 0) {
+
+			this->flexibles.clear();
+
+			for (size_t i = head; i < tail; i++) {
+				if (this->nodes[i]->shrinkFactor > 0) {
+					this->flexibles.push_back(this->nodes[i]);
+				}
+			}
+
+			if (vertical) {
+				this->shrinkNodesVertically(this->flexibles, directionSpace, shrinkablesWeight);
+			} else {
+				this->shrinkNodesHorizontally(this->flexibles, directionSpace, shrinkablesWeight);
+			}
+
+			directionSpace = 0;
+		}
+
+		for (size_t i = head; i < tail; i++) {
+			this->resolveSize(this->nodes[i]);
+		}
+
+		double offset = 0;
+		double spacer = 0;
+
+		switch (this->node->contentDisposition) {
+
+			case kContentDispositionStart:
+				offset = 0;
+				break;
+
+			case kContentDispositionEnd:
+				offset = directionSpace;
+				break;
+
+			case kContentDispositionCenter:
+				offset = directionSpace / 2;
+				break;
+
+			case kContentDispositionSpaceBetween:
+				spacer = length > 1 ? directionSpace / (length - 1) : 0;
+				offset = 0;
+				break;
+
+			case kContentDispositionSpaceEvenly:
+				spacer = directionSpace / (length + 1);
+				offset = spacer;
+				break;
+
+			case kContentDispositionSpaceAround:
+				spacer = directionSpace / (length + 1);
+				offset = spacer / 2;
+				break;
+		}
+
+		for (size_t i = head; i < tail; i++) {
+
+			auto child = this->nodes[i];
+
+			const double marginT = child->measuredMarginTop;
+			const double marginL = child->measuredMarginLeft;
+			const double marginR = child->measuredMarginRight;
+			const double marginB = child->measuredMarginBottom;
+
+			double x = contentL;
+			double y = contentT;
+
+			if (vertical) {
+
+				x = round(x + cross + this->resolveAlignment(child, lineSize), scale);
+				y = round(y + offset + marginT, scale);
+
+				offset = offset + child->measuredHeight + marginT + marginB + spacer;
+
+			} else {
+
+				x = round(x + offset + marginL, scale);
+				y = round(y + cross + this->resolveAlignment(child, lineSize), scale);
+
+				offset = offset + child->measuredWidth + marginL + marginR + spacer;
+			}
+
+			this->position(child, x, y);
+		}
+
+		cross += lineSize;
+
+		head = tail;
+	}
+}
+
+void
+RelativeLayoutResolver::resolveVirtual()
+{
+	const double scale = this->node->display->getScale();
+
+	const double paddingT = this->node->measuredPaddingTop;
+	const double paddingL = this->node->measuredPaddingLeft;
+	const double paddingR = this->node->measuredPaddingRight;
+	const double paddingB = this->node->measuredPaddingBottom;
+
+	const double contentW = max(this->node->measuredContentWidth - paddingL - paddingR, 0.0);
+	const double contentH = max(this->node->measuredContentHeight - paddingT - paddingB, 0.0);
+	const double contentT = this->node->measuredContentTop + paddingT;
+	const double contentL = this->node->measuredContentLeft + paddingL;
+
+	const bool vertical = this->node->contentDirection == kContentDirectionVertical;
+
+	const auto virtualization = this->node->virtualization;
+
+	/*
+	 * The children are positioned in the coordinates of the node so only
+	 * the ones overlapping its inner box, extended by the overscan, are in
+	 * view. A node wrapping its content along the main axis has no such
+	 * box and keeps all of its children in view.
+	 */
+
+	const bool wraps = vertical ? this->node->isWrappingContentHeight() : this->node->isWrappingContentWidth();
+
+	const double viewport = vertical ? this->node->measuredInnerHeight : this->node->measuredInnerWidth;
+
+	const double head = wraps ? ABS_DBL_MIN : -virtualization->overscan;
+	const double tail = wraps ? ABS_DBL_MAX : viewport + virtualization->overscan;
+
+	const double origin = vertical ? contentT : contentL;
+
+	double offset = 0;
+	double remainder = 0;
+
+	const auto &children = this->node->children;
+
+	for (size_t i = 0; i < children.size(); i++) {
+
+		auto child = children[i];
+
+		if (child->visible == false ||
+			child->isRelative() == false) {
+			continue;
+		}
+
+		/*
+		 * Children out of view are neither styled nor measured, they keep
+		 * their last measured extent, or the estimated one, so the content
+		 * size only changes when a child in view is measured.
+		 */
+
+		double extent = virtualization->getExtent(i);
+
+		if (origin + offset + extent < head ||
+			origin + offset > tail) {
+			child->offscreen = true;
+			offset += extent;
+			continue;
+		}
+
+		if (child->offscreen) {
+			child->offscreen = false;
+			child->resolvedSize = false;
+		}
+
+		child->resolveTraits();
+
+		if (child->visible == false) {
+			continue;
+		}
+
+		child->inheritedWrappedContentWidth = child->inheritsWrappedWidth();
+		child->inheritedWrappedContentHeight = child->inheritsWrappedHeight();
+
+		double remainingW = contentW;
+		double remainingH = contentH;
+
+		this->measure(
+			child,
+			remainingW,
+			remainingH,
+			remainder
+		);
+
+		this->resolveSize(child);
+
+		const double marginT = child->measuredMarginTop;
+		const double marginL = child->measuredMarginLeft;
+		const double marginR = child->measuredMarginRight;
+		const double marginB = child->measuredMarginBottom;
+
+		double x = contentL;
+		double y = contentT;
+
+		if (vertical) {
+
+			x = round(x + this->resolveAlignment(child, contentW), scale);
+			y = round(y + offset + marginT, scale);
+
+			extent = child->measuredHeight + marginT + marginB;
+
+		} else {
+
+			x = round(x + offset + marginL, scale);
+			y = round(y + this->resolveAlignment(child, contentH), scale);
+
+			extent = child->measuredWidth + marginL + marginR;
+		}
+
+		virtualization->setExtent(i, extent);
+
+		this->position(child, x, y);
+
+		offset += extent;
+	}
+
+	if (vertical) {
+		this->extentBottom = max(this->extentBottom, origin + offset);
+	} else {
+		this->extentRight = max(this->extentRight, origin + offset);
+	}
+}
+
 //------------------------------------------------------------------------------
 // MARK: Public API
 //------------------------------------------------------------------------------
@@ -370,6 +763,23 @@ RelativeLayoutResolver::measure(DisplayNode* child, double &remainingW, double &
 void
 RelativeLayoutResolver::resolve()
 {
+	if (this->node->isVirtualized()) {
+
+		this->extentTop = 0;
+		this->extentLeft = 0;
+		this->extentRight = 0;
+		this->extentBottom = 0;
+
+		this->resolveVirtual();
+
+		this->extentRight += this->node->measuredPaddingRight;
+		this->extentBottom += this->node->measuredPaddingBottom;
+
+		this->nodes.clear();
+
+		return;
+	}
+
 	if (this->nodes.size() == 0) {
 		return;
 	}
@@ -379,6 +789,18 @@ RelativeLayoutResolver::resolve()
 	this->extentRight = 0;
 	this->extentBottom = 0;
 
+	if (this->node->contentWrap == kContentWrapLines) {
+
+		this->resolveLines();
+
+		this->extentRight += this->node->measuredPaddingRight;
+		this->extentBottom += this->node->measuredPaddingBottom;
+
+		this->nodes.clear();
+
+		return;
+	}
+
 	const double scale = this->node->display->getScale();
 
 	const double paddingT = this->node->measuredPaddingTop;
@@ -494,14 +916,7 @@ RelativeLayoutResolver::resolve()
 		}
 	}
 
-	for (auto child : this->nodes) {
-		if (child->lastMeasuredWidth != child->measuredWidth ||
-			child->lastMeasuredHeight != child->measuredHeight) {
-			child->lastMeasuredWidth = child->measuredWidth;
-			child->lastMeasuredHeight = child->measuredHeight;
-			child->didResolveSize();
-		}
-	}
+	this->resolveSizes(this->nodes);
 
 	double offset = 0;
 	double spacer = 0;
@@ -574,43 +989,7 @@ RelativeLayoutResolver::resolve()
 				abort();
 		}
 
-		const double anchorTop = child->measureAnchorTop();
-		const double anchorLeft = child->measureAnchorLeft();
-
-		const double measuredT = y - anchorTop;
-		const double measuredL = x - anchorLeft;
-		const double measuredR = (child->parent->measuredContentWidth - child->measuredWidth - x) - anchorLeft;
-		const double measuredB = (child->parent->measuredContentHeight - child->measuredHeight - y) - anchorTop;
-
-		if (child->measuredTop != measuredT ||
-			child->measuredLeft != measuredL ||
-			child->measuredRight != measuredR ||
-			child->measuredBottom != measuredB) {
-
-			child->measuredTop = measuredT;
-			child->measuredLeft = measuredL;
-			child->measuredRight = measuredR;
-			child->measuredBottom = measuredB;
-
-			child->didResolveOrigin();
-		}
-
-		this->extentTop = min(this->extentTop, child->measuredTop + child->measuredMarginTop);
-		this->extentLeft = min(this->extentLeft, child->measuredLeft + child->measuredMarginBottom);
-		this->extentRight = max(this->extentRight, child->measuredLeft + child->measuredWidth + child->measuredMarginRight);
-		this->extentBottom = max(this->extentBottom, child->measuredTop + child->measuredHeight + child->measuredMarginBottom);
-
-		child->invalidSize = false;
-		child->invalidOrigin = false;
-
-		child->resolvedSize = true;
-		child->resolvedOrigin = true;
-		child->resolvedParent = this->node;
-
-		child->resolveBorders();
-		child->resolveInnerSize();
-		child->resolveContentSize();
-		child->resolvePadding();
+		this->position(child, x, y);
 	}
 
 	this->extentRight += paddingR;
@@ -22,6 +22,7 @@ private:
 	DisplayNode* node;
 
 	vector<DisplayNode*> nodes;
+	vector<DisplayNode*> flexibles;
 
 	double extentTop = 0;
 	double extentLeft = 0;
@@ -49,6 +50,13 @@ private:
 	void shrinkNodesVertically(const vector<DisplayNode*> &nodes, double space, double weights);
 	void shrinkNodesHorizontally(const vector<DisplayNode*> &nodes, double space, double weights);
 
+	void position(DisplayNode* node, double x, double y);
+
+	void resolveSize(DisplayNode* node);
+	void resolveSizes(const vector<DisplayNode*> &nodes);
+	void resolveLines();
+	void resolveVirtual();
+
 public:
 
 	friend class LayoutResolver;
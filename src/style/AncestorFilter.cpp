@@ -0,0 +1,145 @@
+#include "AncestorFilter.h"
+#include "DisplayNode.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace Dezel {
+namespace Style {
+
+using std::find;
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+void
+AncestorFilter::add(unsigned key)
+{
+	/*
+	 * A counter that reached its maximum is never decremented, the key it
+	 * belongs to can no longer be rejected but the filter stays correct.
+	 */
+
+	auto& a = this->counts[hashA(key)];
+	auto& b = this->counts[hashB(key)];
+
+	if (a < UINT8_MAX) a++;
+	if (b < UINT8_MAX) b++;
+
+	this->keys.push_back(key);
+}
+
+void
+AncestorFilter::push(DisplayNode* node)
+{
+	this->nodes.push_back(node);
+	this->offsets.push_back(this->keys.size());
+
+	if (node->getName()) {
+		this->add(nameKey(node->getName()));
+	}
+
+	for (auto type : node->getTypes()) this->add(typeKey(type));
+	for (auto style : node->getStyles()) this->add(styleKey(style));
+}
+
+void
+AncestorFilter::pop()
+{
+	const auto offset = this->offsets.back();
+
+	for (size_t i = offset; i < this->keys.size(); i++) {
+
+		auto& a = this->counts[hashA(this->keys[i])];
+		auto& b = this->counts[hashB(this->keys[i])];
+
+		if (a < UINT8_MAX) a--;
+		if (b < UINT8_MAX) b--;
+	}
+
+	this->keys.resize(offset);
+	this->offsets.pop_back();
+	this->nodes.pop_back();
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+AncestorFilter::sync(DisplayNode* parent, unsigned version)
+{
+	/*
+	 * The keys of an ancestor are read once when it is pushed. The filter
+	 * is built again when the traits of any node of the display changed
+	 * since, as given by the version.
+	 */
+
+	if (this->version != version) {
+		this->version = version;
+		this->clear();
+	}
+
+	/*
+	 * The nodes are styled from the top of the tree down, the parent of the
+	 * next node is usually the last ancestor pushed or one of its children.
+	 * Only the part of the path that differs is popped and pushed again.
+	 */
+
+	if (this->nodes.size() &&
+		this->nodes.back() == parent) {
+		return;
+	}
+
+	this->path.clear();
+
+	auto node = parent;
+
+	while (node) {
+
+		auto it = find(
+			this->nodes.rbegin(),
+			this->nodes.rend(),
+			node
+		);
+
+		if (it != this->nodes.rend()) {
+
+			const auto count = distance(this->nodes.rbegin(), it);
+
+			for (long i = 0; i < count; i++) {
+				this->pop();
+			}
+
+			break;
+		}
+
+		this->path.push_back(node);
+
+		node = node->getParent();
+	}
+
+	if (node == nullptr) {
+		while (this->nodes.size()) {
+			this->pop();
+		}
+	}
+
+	for (auto it = this->path.rbegin(); it != this->path.rend(); it++) {
+		this->push(*it);
+	}
+}
+
+void
+AncestorFilter::clear()
+{
+	this->nodes.clear();
+	this->offsets.clear();
+	this->keys.clear();
+
+	memset(this->counts, 0, sizeof(this->counts));
+}
+
+}
+}
@@ -0,0 +1,77 @@
+#ifndef AncestorFilter_h
+#define AncestorFilter_h
+
+#include "Atom.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace Dezel {
+	class DisplayNode;
+}
+
+namespace Dezel {
+namespace Style {
+
+using std::vector;
+
+class AncestorFilter {
+
+private:
+
+	/*
+	 * A counting Bloom filter of the name, types and styles of the
+	 * ancestors of the node being styled. Each key sets two counters, a key
+	 * is certainly absent when any of them is zero.
+	 */
+
+	static const size_t capacity = 4096;
+
+	uint8_t counts[capacity] = {};
+
+	unsigned version = 0;
+
+	vector<DisplayNode*> nodes;
+	vector<size_t> offsets;
+	vector<unsigned> keys;
+	vector<DisplayNode*> path;
+
+	static unsigned hashA(unsigned key) {
+		return (key * 0x9E3779B1u) >> 20;
+	}
+
+	static unsigned hashB(unsigned key) {
+		return (key * 0x85EBCA77u) >> 20;
+	}
+
+	void add(unsigned key);
+	void push(DisplayNode* node);
+	void pop();
+
+public:
+
+	static unsigned nameKey(Atom atom) {
+		return atom << 2 | 0;
+	}
+
+	static unsigned typeKey(Atom atom) {
+		return atom << 2 | 1;
+	}
+
+	static unsigned styleKey(Atom atom) {
+		return atom << 2 | 2;
+	}
+
+	void sync(DisplayNode* parent, unsigned version);
+	void clear();
+
+	bool mayContain(unsigned key) const {
+		return this->counts[hashA(key)] && this->counts[hashB(key)];
+	}
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "Arena.h"
+
+#include <string.h>
+
+namespace Dezel {
+namespace Style {
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+void*
+Arena::allocate(size_t size, size_t alignment)
+{
+	if (this->blocks.size()) {
+
+		auto& block = this->blocks.back();
+
+		auto offset = (block.used + alignment - 1) & ~(alignment - 1);
+
+		if (offset + size <= block.size) {
+			block.used = offset + size;
+			return block.data + offset;
+		}
+	}
+
+	/*
+	 * An object larger than a block gets a block of its own. The memory
+	 * given by the global allocator is aligned for any type.
+	 */
+
+	auto length = size > blockSize ? size : blockSize;
+
+	Block block;
+	block.data = static_cast<char*>(::operator new(length));
+	block.size = length;
+	block.used = size;
+
+	this->blocks.push_back(block);
+
+	this->allocated += length;
+
+	return block.data;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+Arena::~Arena()
+{
+	for (auto it = this->destructors.rbegin(); it != this->destructors.rend(); it++) {
+		it->destroy(it->object);
+	}
+
+	for (auto& block : this->blocks) {
+		::operator delete(block.data);
+	}
+}
+
+const char*
+Arena::copy(const string& text)
+{
+	auto data = static_cast<char*>(this->allocate(text.size() + 1, 1));
+	memcpy(data, text.c_str(), text.size() + 1);
+	return data;
+}
+
+}
+}
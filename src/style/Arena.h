@@ -0,0 +1,81 @@
+#ifndef Arena_h
+#define Arena_h
+
+#include <new>
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <stddef.h>
+
+namespace Dezel {
+namespace Style {
+
+using std::string;
+using std::vector;
+
+class Arena {
+
+private:
+
+	/*
+	 * Objects are placed one after the other in large blocks and are all
+	 * released with the arena. Objects that need their destructor called,
+	 * to release a string or a vector, are recorded and destroyed in the
+	 * reverse order of their creation.
+	 */
+
+	struct Block {
+		char* data;
+		size_t size;
+		size_t used;
+	};
+
+	struct Destructor {
+		void* object;
+		void (*destroy)(void* object);
+	};
+
+	static const size_t blockSize = 16 * 1024;
+
+	vector<Block> blocks;
+	vector<Destructor> destructors;
+
+	size_t allocated = 0;
+
+	void* allocate(size_t size, size_t alignment);
+
+public:
+
+	Arena() = default;
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	~Arena();
+
+	template<typename T, typename... Args>
+	T* create(Args&&... args) {
+
+		auto object = new (this->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+		if (std::is_trivially_destructible<T>::value == false) {
+			this->destructors.push_back({object, [](void* object) {
+				static_cast<T*>(object)->~T();
+			}});
+		}
+
+		return object;
+	}
+
+	const char* copy(const string& text);
+
+	size_t getMemoryUsage() const {
+		return this->allocated + this->destructors.capacity() * sizeof(Destructor);
+	}
+
+};
+
+}
+}
+
+#endif
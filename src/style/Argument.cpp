@@ -9,9 +9,7 @@ namespace Style {
 
 Argument::~Argument()
 {
-	for (auto value : this->values) {
-		delete value;
-	}
+
 }
 
 string
@@ -25,7 +23,7 @@ Argument::toString()
 			output.append(" ");
 		}
 
-		output.append(value->toString());
+		output.append(value.toString());
 	}
 
 	return output;
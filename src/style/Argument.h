@@ -19,7 +19,7 @@ class Argument {
 
 private:
 
-	vector<Value*> values;
+	vector<Value> values;
 
 public:
 
@@ -28,7 +28,7 @@ public:
 
 	~Argument();
 
-	const vector<Value*>& getValues() const {
+	const vector<Value>& getValues() const {
 		return this->values;
 	}
 
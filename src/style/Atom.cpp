@@ -0,0 +1,93 @@
+#include "Atom.h"
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+namespace Dezel {
+namespace Style {
+
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+using std::unordered_map;
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+struct AtomTable {
+
+	/*
+	 * The strings are owned by the map, its keys never move once inserted
+	 * so the table can hand out references to them.
+	 */
+
+	mutex lock;
+
+	unordered_map<string, Atom> atoms;
+	vector<const string*> strings;
+
+	AtomTable() {
+		this->strings.push_back(&this->atoms.emplace("", 0).first->first);
+	}
+};
+
+static AtomTable& table()
+{
+	static AtomTable table;
+	return table;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+Atom
+Atoms::intern(const string& value)
+{
+	auto& table = Style::table();
+
+	lock_guard<mutex> guard(table.lock);
+
+	auto it = table.atoms.find(value);
+
+	if (it != table.atoms.end()) {
+		return it->second;
+	}
+
+	auto atom = static_cast<Atom>(table.strings.size());
+
+	table.strings.push_back(&table.atoms.emplace(value, atom).first->first);
+
+	return atom;
+}
+
+Atom
+Atoms::find(const string& value)
+{
+	auto& table = Style::table();
+
+	lock_guard<mutex> guard(table.lock);
+
+	auto it = table.atoms.find(value);
+
+	if (it != table.atoms.end()) {
+		return it->second;
+	}
+
+	return 0;
+}
+
+const string&
+Atoms::resolve(Atom atom)
+{
+	auto& table = Style::table();
+
+	lock_guard<mutex> guard(table.lock);
+
+	return *table.strings[atom];
+}
+
+}
+}
@@ -0,0 +1,33 @@
+#ifndef Atom_h
+#define Atom_h
+
+#include <string>
+
+namespace Dezel {
+namespace Style {
+
+using std::string;
+
+/*
+ * An atom identifies a string interned in the process wide atom table,
+ * two atoms are equal when their strings are. The empty string is always
+ * the atom 0.
+ */
+
+typedef unsigned int Atom;
+
+class Atoms {
+
+public:
+
+	static Atom intern(const string& value);
+	static Atom find(const string& value);
+
+	static const string& resolve(Atom atom);
+
+};
+
+}
+}
+
+#endif
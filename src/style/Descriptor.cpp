@@ -2,6 +2,7 @@
 #include "Selector.h"
 #include "Fragment.h"
 #include "Importance.h"
+#include "AncestorFilter.h"
 #include "DisplayNode.h"
 
 #include <iostream>
@@ -28,74 +29,61 @@ Descriptor::setParentFragment(Descriptor* descriptor)
 bool
 Descriptor::matchNode(DisplayNode* node, Importance& importance)
 {
-	return this->selector->getTail()->match(node, importance);
+	return this->selector->getProgram().matchNode(node, importance);
 }
 
 bool
 Descriptor::matchPath(DisplayNode* node, Importance& importance)
 {
-	auto test = this->selector->getTail();
+	return this->selector->getProgram().matchPath(node, importance);
+}
 
-	if (test->hasStyle() ||
-		test->hasState()) {
+bool
+Descriptor::matchAncestors(const AncestorFilter& filter)
+{
+	for (auto key : this->ancestorKeys) {
+		if (filter.mayContain(key) == false) {
+			return false;
+		}
+	}
 
-		test = test->getParent();
+	return true;
+}
 
-	} else {
+void
+Descriptor::prepareAncestorKeys()
+{
+	/*
+	 * Gathers the traits the ancestors of a node must have for the path
+	 * to match. The fragments which follow a style or state fragment from
+	 * the tail can match the node itself and are left out, so are the
+	 * fragments that match any of several styles.
+	 */
 
-		test = test->getParent();
-		node = node->getParent();
+	this->ancestorKeys.clear();
 
-	}
+	auto fragment = this->selector->getTail();
 
-	if (test == nullptr) {
-		return true;
-	}
+	bool self = fragment->hasStyle() || fragment->hasState();
 
-	while (node) {
+	fragment = fragment->getParent();
 
-		bool match = test->match(node, importance);
+	while (fragment) {
 
-		if (match == false) {
+		if (self == false) {
 
-			/*
-			 * The selector fragment didn't match the current node. Before
-			 * trying with the parent node, we must check whether the node is
-			 * the root of an opaque node.
-			 */
+			if (fragment->getName()) this->ancestorKeys.push_back(AncestorFilter::nameKey(fragment->getName()));
+			if (fragment->getType()) this->ancestorKeys.push_back(AncestorFilter::typeKey(fragment->getType()));
 
-			if (node->isOpaque() ||
-				node->isWindow()) {
-				break;
+			if (fragment->getStyles().size() == 1) {
+				this->ancestorKeys.push_back(AncestorFilter::styleKey(fragment->getStyles()[0]));
 			}
-
-			/*
-			 * Try the same selector fragment with the parent node.
-			 */
-
-			 node = node->getParent();
-
-			 continue;
 		}
 
-		if (test->hasStyle() ||
-			test->hasState()) {
-
-			test = test->getParent();
+		self = self && (fragment->hasStyle() || fragment->hasState());
 
-		} else {
-
-			test = test->getParent();
-			node = node->getParent();
-
-		}
-
-		if (test == nullptr) {
-			return true;
-		}
+		fragment = fragment->getParent();
 	}
-
-	return false;
 }
 
 //------------------------------------------------------------------------------
@@ -126,12 +114,29 @@ Descriptor::addStateDescriptor(Descriptor* state)
 }
 
 bool
-Descriptor::match(DisplayNode* node, Importance& importance)
+Descriptor::match(DisplayNode* node, Importance& importance, const AncestorFilter& filter)
 {
-	return (
-		this->matchNode(node, importance) &&
-		this->matchPath(node, importance)
-	);
+	/*
+	 * The filter holds every ancestor up to the window, the path walk is
+	 * still the one that decides, the filter only rejects the paths that
+	 * cannot be found among the ancestors at all.
+	 */
+
+	if (this->matchNode(node, importance) &&
+		this->matchAncestors(filter) &&
+		this->matchPath(node, importance)) {
+
+		auto& base = this->selector->getProgram().getImportance();
+
+		importance.name += base.name;
+		importance.type += base.type;
+		importance.style += base.style;
+		importance.state += base.state;
+
+		return true;
+	}
+
+	return false;
 }
 
 string
@@ -26,6 +26,7 @@ class Stylesheet;
 class Selector;
 class Fragment;
 class Importance;
+class AncestorFilter;
 
 class Descriptor {
 
@@ -41,11 +42,18 @@ private:
 	vector<Descriptor*> styleDescriptors;
 	vector<Descriptor*> stateDescriptors;
 
+	vector<unsigned> ancestorKeys;
+
+	size_t order = 0;
+
 	void setParentSelector(Descriptor* descriptor);
 	void setParentFragment(Descriptor* descriptor);
 
 	bool matchNode(DisplayNode* node, Importance& importance);
 	bool matchPath(DisplayNode* node, Importance& importance);
+	bool matchAncestors(const AncestorFilter& filter);
+
+	void prepareAncestorKeys();
 
 public:
 
@@ -60,6 +68,10 @@ public:
 		return this->selector;
 	}
 
+	size_t getOrder() const {
+		return this->order;
+	}
+
 	const PropertyList& getProperties() const {
 		return this->properties;
 	}
@@ -84,7 +96,7 @@ public:
 		this->properties.add(property);
 	}
 
-	bool match(DisplayNode* node, Importance& importance);
+	bool match(DisplayNode* node, Importance& importance, const AncestorFilter& filter);
 
 	string toString(int depth = 0);
 
@@ -18,7 +18,7 @@ using std::distance;
 bool
 Fragment::matchName(DisplayNode* node, Importance& importance)
 {
-	if (this->name == "") {
+	if (this->name == 0) {
 
 		/*
 		 * This fragment des not specify a name. Consider it a match
@@ -41,7 +41,7 @@ Fragment::matchName(DisplayNode* node, Importance& importance)
 bool
 Fragment::matchType(DisplayNode* node, Importance& importance)
 {
-	if (this->type == "") {
+	if (this->type == 0) {
 
 		/*
 		 * This fragment des not specify a type which in this case defaults
@@ -58,7 +58,7 @@ Fragment::matchType(DisplayNode* node, Importance& importance)
 	 * Try to find the fragment type within the node's type vector.
 	 */
 
-	auto types = node->getTypes();
+	auto& types = node->getTypes();
 
 	auto beg = types.begin();
 	auto end = types.end();
@@ -100,7 +100,7 @@ Fragment::matchStyle(DisplayNode* node, Importance& importance)
 		return true;
 	}
 
-	auto styles = node->getStyles();
+	auto& styles = node->getStyles();
 
 	if (styles.size() == 0) {
 		return false;
@@ -116,7 +116,7 @@ Fragment::matchStyle(DisplayNode* node, Importance& importance)
 
 	bool success = false;
 
-	for (auto& style : this->styles) {
+	for (auto style : this->styles) {
 
 		auto it = find(
 			beg,
@@ -149,7 +149,7 @@ Fragment::matchState(DisplayNode* node, Importance& importance)
 		return true;
 	}
 
-	auto states = node->getStates();
+	auto& states = node->getStates();
 
 	if (states.size() == 0) {
 		return false;
@@ -165,7 +165,7 @@ Fragment::matchState(DisplayNode* node, Importance& importance)
 
 	bool success = false;
 
-	for (auto& state : this->states) {
+	for (auto state : this->states) {
 
 		auto it = find(
 			beg,
@@ -219,24 +219,24 @@ Fragment::toString(int depth)
 {
 	string output;
 
-	output.append(this->type);
+	output.append(Atoms::resolve(this->type));
 
-	if (this->name.size()) {
+	if (this->name) {
 		output.append("#");
-		output.append(this->name);
+		output.append(Atoms::resolve(this->name));
 	}
 
 	if (this->styles.size()) {
 		for (auto style : this->styles) {
 			output.append(".");
-			output.append(style);
+			output.append(Atoms::resolve(style));
 		}
 	}
 
 	if (this->states.size()) {
 		for (auto state : this->states) {
 			output.append(":");
-			output.append(state);
+			output.append(Atoms::resolve(state));
 		}
 	}
 
@@ -1,6 +1,8 @@
 #ifndef Fragment_h
 #define Fragment_h
 
+#include "Atom.h"
+
 #include <string>
 #include <vector>
 
@@ -29,10 +31,10 @@ private:
 	Fragment* prev = nullptr;
 	Fragment* next = nullptr;
 
-	string name = "";
-	string type = "";
-	vector<string> styles;
-	vector<string> states;
+	Atom name = 0;
+	Atom type = 0;
+	vector<Atom> styles;
+	vector<Atom> states;
 
 	bool matchName(DisplayNode* node, Importance& importance);
 	bool matchType(DisplayNode* node, Importance& importance);
@@ -61,19 +63,19 @@ public:
 		return this->next;
 	}
 
-	const string& getName() const {
+	Atom getName() const {
 		return this->name;
 	}
 
-	const string& getType() const {
+	Atom getType() const {
 		return this->type;
 	}
 
-	const vector<string>& getStyles() const {
+	const vector<Atom>& getStyles() const {
 		return this->styles;
 	}
 
-	const vector<string>& getStates() const {
+	const vector<Atom>& getStates() const {
 		return this->states;
 	}
 
@@ -17,7 +17,7 @@ class Function {
 
 public:
 
-	typedef void (*Callback)(const Function* function, const vector<Argument*>& arguments, vector<Value*>& result);
+	typedef void (*Callback)(const Function* function, const vector<Argument*>& arguments, vector<Value>& result);
 
 private:
 
@@ -39,7 +39,7 @@ public:
 		return this->name;
 	}
 
-	const void invoke(const vector<Argument*>& arguments, vector<Value*>& result) const {
+	const void invoke(const vector<Argument*>& arguments, vector<Value>& result) const {
 		this->callback(this, arguments, result);
 	}
 };
@@ -8,18 +8,18 @@ namespace Style {
 // MARK: Public API
 //------------------------------------------------------------------------------
 
-FunctionValue::FunctionValue(string name) : Value(kValueTypeFunction, kValueUnitNone), name(name)
+FunctionValue::FunctionValue(string name) : name(name)
 {
 
 }
 
 FunctionValue::~FunctionValue()
 {
-	for (auto argument : this->arguments) delete argument;
+
 }
 
 bool
-FunctionValue::evaluate(Stylesheet* stylesheet, vector<Value*>& result)
+FunctionValue::evaluate(Stylesheet* stylesheet, vector<Value>& result)
 {
 	auto function = stylesheet->getFunction(this->name);
 
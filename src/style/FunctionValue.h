@@ -16,7 +16,7 @@ using std::vector;
 class Parser;
 class Stylesheet;
 
-class FunctionValue : public Value {
+class FunctionValue {
 
 private:
 
@@ -39,7 +39,7 @@ public:
 		return this->arguments;
 	}
 
-	bool evaluate(Stylesheet* stylesheet, vector<Value*>& result);
+	bool evaluate(Stylesheet* stylesheet, vector<Value>& result);
 
 	string toString();
 
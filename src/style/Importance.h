@@ -2,6 +2,7 @@
 #define Importance_h
 
 #include <string>
+#include <stdint.h>
 
 namespace Dezel {
 namespace Style {
@@ -10,6 +11,21 @@ using std::string;
 
 struct Importance {
 
+private:
+
+	static uint64_t clamp(int value, int bits) {
+
+		if (value < 0) {
+			return 0;
+		}
+
+		uint64_t max = (1ull << bits) - 1;
+
+		return static_cast<uint64_t>(value) > max ? max : static_cast<uint64_t>(value);
+	}
+
+public:
+
 	int type = 0;
 	int name = 0;
 	int style = 0;
@@ -25,19 +41,29 @@ struct Importance {
 	}
 
 	bool operator > (const Importance& b) const {
-		if (this->style > b.style) return true;
-		if (this->state > b.state) return true;
-		if (this->name > b.name) return true;
-		if (this->type > b.type) return true;
-		return false;
+		return b < *this;
 	}
 
 	bool operator < (const Importance& b) const {
-		if (this->style < b.style) return true;
-		if (this->state < b.state) return true;
-		if (this->name < b.name) return true;
-		if (this->type < b.type) return true;
-		return false;
+		if (this->style != b.style) return this->style < b.style;
+		if (this->state != b.state) return this->state < b.state;
+		if (this->name != b.name) return this->name < b.name;
+		return this->type < b.type;
+	}
+
+	/**
+	 * Packs the importance and the order of the rule within its stylesheet
+	 * into a key that sorts the same way, the order breaking the ties.
+	 * Fields larger than their bits are clamped.
+	 */
+	uint64_t pack(uint64_t order) const {
+		return (
+			clamp(this->style, 10) << 54 |
+			clamp(this->state, 10) << 44 |
+			clamp(this->name, 8) << 36 |
+			clamp(this->type, 12) << 24 |
+			(order & 0xFFFFFF)
+		);
 	}
 
 	string toString() const;
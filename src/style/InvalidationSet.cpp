@@ -0,0 +1,58 @@
+#include "InvalidationSet.h"
+#include "Fragment.h"
+#include "DisplayNode.h"
+
+namespace Dezel {
+namespace Style {
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+InvalidationSet::add(Fragment* fragment)
+{
+	if (fragment->getName()) {
+		this->names.insert(fragment->getName());
+		return;
+	}
+
+	if (fragment->hasStyle()) {
+		for (auto style : fragment->getStyles()) this->styles.insert(style);
+		return;
+	}
+
+	if (fragment->hasState()) {
+		for (auto state : fragment->getStates()) this->states.insert(state);
+		return;
+	}
+
+	if (fragment->getType()) {
+		this->types.insert(fragment->getType());
+		return;
+	}
+
+	this->universal = true;
+}
+
+bool
+InvalidationSet::match(DisplayNode* node) const
+{
+	if (this->universal) {
+		return true;
+	}
+
+	if (this->names.size() &&
+		this->names.count(node->getName())) {
+		return true;
+	}
+
+	for (auto type : node->getTypes()) if (this->types.count(type)) return true;
+	for (auto style : node->getStyles()) if (this->styles.count(style)) return true;
+	for (auto state : node->getStates()) if (this->states.count(state)) return true;
+
+	return false;
+}
+
+}
+}
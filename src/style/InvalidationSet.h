@@ -0,0 +1,47 @@
+#ifndef InvalidationSet_h
+#define InvalidationSet_h
+
+#include "Atom.h"
+
+#include <unordered_set>
+
+namespace Dezel {
+	class DisplayNode;
+}
+
+namespace Dezel {
+namespace Style {
+
+using std::unordered_set;
+
+class Fragment;
+
+class InvalidationSet {
+
+private:
+
+	/*
+	 * Holds the traits of the nodes that can be affected when a style or
+	 * state changes on one of their ancestors. A rule contributes the same
+	 * trait of its tail fragment it is filed under in the rule index.
+	 */
+
+	unordered_set<Atom> names;
+	unordered_set<Atom> types;
+	unordered_set<Atom> styles;
+	unordered_set<Atom> states;
+
+	bool universal = false;
+
+public:
+
+	void add(Fragment* fragment);
+
+	bool match(DisplayNode* node) const;
+
+};
+
+}
+}
+
+#endif
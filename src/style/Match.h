@@ -22,6 +22,8 @@ public:
 
 	Importance importance;
 
+	uint64_t key = 0;
+
 	Descriptor* getDescriptor() const {
 		return this->descriptor;
 	}
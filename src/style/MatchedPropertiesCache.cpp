@@ -0,0 +1,152 @@
+#include "MatchedPropertiesCache.h"
+#include "Descriptor.h"
+#include "Matches.h"
+#include "Match.h"
+#include "PropertyList.h"
+
+#include <functional>
+
+namespace Dezel {
+namespace Style {
+
+using std::lock_guard;
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+size_t
+MatchedPropertiesCache::hash(const Matches& matches)
+{
+	size_t hash = matches.size();
+
+	for (auto& match : matches) {
+		hash ^= std::hash<Descriptor*>()(match.getDescriptor()) + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+	}
+
+	return hash;
+}
+
+bool
+MatchedPropertiesCache::equals(const Entry& entry, const Matches& matches)
+{
+	if (entry.descriptors.size() != matches.size()) {
+		return false;
+	}
+
+	for (size_t i = 0; i < matches.size(); i++) {
+		if (entry.descriptors[i] != matches[i].getDescriptor()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const PropertyList*
+MatchedPropertiesCache::find(size_t hash, const Matches& matches)
+{
+	auto it = this->entries.find(hash);
+
+	if (it == this->entries.end()) {
+		return nullptr;
+	}
+
+	for (auto& entry : it->second) {
+		if (equals(entry, matches)) {
+			return entry.properties;
+		}
+	}
+
+	return nullptr;
+}
+
+void
+MatchedPropertiesCache::clear()
+{
+	for (auto& bucket : this->entries) {
+		for (auto& entry : bucket.second) {
+			entry.properties->release();
+		}
+	}
+
+	this->entries.clear();
+
+	this->count = 0;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+MatchedPropertiesCache::~MatchedPropertiesCache()
+{
+	this->clear();
+}
+
+const PropertyList*
+MatchedPropertiesCache::get(const Matches& matches)
+{
+	/*
+	 * The list is returned retained, the caller has to release it once
+	 * it no longer uses it.
+	 */
+
+	const auto hash = MatchedPropertiesCache::hash(matches);
+
+	{
+		lock_guard<mutex> guard(this->lock);
+
+		auto properties = this->find(hash, matches);
+
+		if (properties) {
+			properties->retain();
+			return properties;
+		}
+	}
+
+	/*
+	 * The properties are merged without holding the lock, another thread
+	 * may have stored the same list in the meantime.
+	 */
+
+	auto properties = new PropertyList();
+
+	for (auto& match : matches) {
+		properties->merge(match.getDescriptor()->getProperties());
+	}
+
+	lock_guard<mutex> guard(this->lock);
+
+	auto existing = this->find(hash, matches);
+
+	if (existing) {
+		delete properties;
+		existing->retain();
+		return existing;
+	}
+
+	if (this->count == capacity) {
+		this->clear();
+	}
+
+	Entry entry;
+	entry.properties = properties;
+	entry.descriptors.reserve(matches.size());
+
+	for (auto& match : matches) {
+		entry.descriptors.push_back(match.getDescriptor());
+	}
+
+	this->entries[hash].push_back(entry);
+
+	this->count++;
+
+	properties->retain();
+	properties->retain();
+
+	return properties;
+}
+
+}
+}
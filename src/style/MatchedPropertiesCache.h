@@ -0,0 +1,61 @@
+#ifndef MatchedPropertiesCache_h
+#define MatchedPropertiesCache_h
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+namespace Dezel {
+namespace Style {
+
+using std::mutex;
+using std::vector;
+using std::unordered_map;
+
+class Descriptor;
+class Matches;
+class PropertyList;
+
+class MatchedPropertiesCache {
+
+private:
+
+	/*
+	 * Nodes matching the same descriptors in the same order end up with
+	 * the same properties. The merged list is built once and shared by
+	 * all of them, it is never modified afterwards. The cache is cleared
+	 * once it holds too many lists, the nodes keep the ones they use.
+	 */
+
+	static const size_t capacity = 1024;
+
+	struct Entry {
+		vector<Descriptor*> descriptors;
+		PropertyList* properties;
+	};
+
+	unordered_map<size_t, vector<Entry>> entries;
+
+	size_t count = 0;
+
+	mutex lock;
+
+	static size_t hash(const Matches& matches);
+	static bool equals(const Entry& entry, const Matches& matches);
+
+	const PropertyList* find(size_t hash, const Matches& matches);
+
+	void clear();
+
+public:
+
+	~MatchedPropertiesCache();
+
+	const PropertyList* get(const Matches& matches);
+
+};
+
+}
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include "Match.h"
 #include "Selector.h"
 #include "Fragment.h"
+#include "RuleIndex.h"
+#include "AncestorFilter.h"
 #include "DisplayNode.h"
 
 namespace Dezel {
@@ -17,19 +19,33 @@ using std::sort;
 //------------------------------------------------------------------------------
 
 bool
-Matcher::match(DisplayNode* node, Matches& matches, const vector<Descriptor*>& descriptors)
+Matcher::match(DisplayNode* node, Matches& matches, const Stylesheet* stylesheet, const AncestorFilter& filter)
 {
 	bool matched = false;
 
-	for (auto descriptor : descriptors) {
+	/*
+	 * Only the rules which tail fragment can match one of the traits of
+	 * the node are tested, the other ones cannot match.
+	 */
+
+	vector<size_t> candidates;
+
+	stylesheet->getRuleIndex().collect(node, candidates);
+
+	auto& descriptors = stylesheet->getRuleDescriptors();
+
+	for (auto index : candidates) {
+
+		auto descriptor = descriptors[index];
 
 		Importance importance;
 
-		if (descriptor->match(node, importance)) {
+		if (descriptor->match(node, importance, filter)) {
 
 			Match match;
 			match.descriptor = descriptor;
 			match.importance = importance;
+			match.key = importance.pack(descriptor->getOrder());
 
 			matches.push_back(match);
 			matched = true;
@@ -17,12 +17,13 @@ class Descriptor;
 class Selector;
 class Fragment;
 class Matches;
+class AncestorFilter;
 
 class Matcher {
 
 public:
 
-	bool match(DisplayNode* node, Matches& matches, const vector<Descriptor*>& descriptors);
+	bool match(DisplayNode* node, Matches& matches, const Stylesheet* stylesheet, const AncestorFilter& filter);
 	// tood matcher recursive
 };
 
@@ -1,29 +1,23 @@
 #include "Matches.h"
-#include "Descriptor.h"
-#include "Selector.h"
 
 #include <algorithm>
 
 namespace Dezel {
 namespace Style {
 
-static bool importance(const Match& a, const Match& b) {
-
-	if (a.importance == b.importance) {
-		return (
-			a.getDescriptor()->getSelector()->getOffset() < b.getDescriptor()->getSelector()->getOffset()
-		);
-	}
-
-	return a.importance < b.importance;
-}
-
 void Matches::order()
 {
-	std::sort(
+	/*
+	 * The packed keys already break the ties with the order of the rules
+	 * in the stylesheet, the matches are never dereferenced while sorting.
+	 */
+
+	std::stable_sort(
 		this->begin(),
 		this->end(),
-		importance
+		[](const Match& a, const Match& b) {
+			return a.key < b.key;
+		}
 	);
 }
 
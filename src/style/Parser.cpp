@@ -6,10 +6,6 @@
 #include "Selector.h"
 #include "Fragment.h"
 #include "Argument.h"
-#include "NullValue.h"
-#include "StringValue.h"
-#include "NumberValue.h"
-#include "BooleanValue.h"
 #include "FunctionValue.h"
 #include "VariableValue.h"
 #include "ParseException.h"
@@ -17,11 +13,13 @@
 #include <iostream>
 #include <string>
 #include <assert.h>
+#include <string.h>
 
 namespace Dezel {
 namespace Style {
 
 using std::string;
+using std::stod;
 
 void
 Parser::parse(Stylesheet* stylesheet, const string& source)
@@ -40,11 +38,19 @@ Parser::parse(Stylesheet* stylesheet, const string& source, const string& url)
 }
 
 void
-Parser::parse(vector<Value*>& values, const string& source)
+Parser::parse(vector<Value>& values, const string& source)
 {
 	TokenizerStream stream(source);
 	Tokenizer tokenizer(stream);
-	Parser parser(values, &tokenizer);
+	Parser parser(values, &tokenizer, nullptr);
+}
+
+void
+Parser::parse(vector<Value>& values, const string& source, Arena* arena)
+{
+	TokenizerStream stream(source);
+	Tokenizer tokenizer(stream);
+	Parser parser(values, &tokenizer, arena);
 }
 
 Parser::Parser(Stylesheet* stylesheet, Tokenizer* tokenizer) : Parser(stylesheet, tokenizer, "<anonymous file>")
@@ -52,7 +58,7 @@ Parser::Parser(Stylesheet* stylesheet, Tokenizer* tokenizer) : Parser(stylesheet
 
 }
 
-Parser::Parser(Stylesheet* stylesheet, Tokenizer* tokenizer, string file) : stylesheet(stylesheet), tokenizer(tokenizer), file(file)
+Parser::Parser(Stylesheet* stylesheet, Tokenizer* tokenizer, string file) : stylesheet(stylesheet), tokenizer(tokenizer), arena(&stylesheet->arena), file(file)
 {
 	auto tokens = this->tokenizer->getTokens();
 
@@ -77,7 +83,7 @@ Parser::Parser(Stylesheet* stylesheet, Tokenizer* tokenizer, string file) : styl
 	} while (tokens.hasNextToken());
 }
 
-Parser::Parser(vector<Value*>& values, Tokenizer* tokenizer) : stylesheet(nullptr), tokenizer(tokenizer), file("<anonymous file>")
+Parser::Parser(vector<Value>& values, Tokenizer* tokenizer, Arena* arena) : stylesheet(nullptr), tokenizer(tokenizer), arena(arena), file("<anonymous file>")
 {
 	auto tokens = this->tokenizer->getTokens();
 
@@ -210,32 +216,29 @@ Parser::parseProperty(TokenList& tokens, Descriptor* target)
 }
 
 bool
-Parser::parseValueAndEvaluate(TokenList& tokens, vector<Value*>& values)
+Parser::parseValueAndEvaluate(TokenList& tokens, vector<Value>& values)
 {
-	auto value = this->parseValue(tokens);
+	Value value;
 
-	if (value == nullptr) {
+	if (this->parseValue(tokens, value) == false) {
 		return false;
 	}
 
-	if (value->getType() == kValueTypeVariable && this->evaluateVariable(value, values)) {
+	if (value.getType() == kValueTypeVariable && this->evaluateVariable(value, values)) {
 
 		/*
-		 * The parsed value has been replaced by the function or variable
-		 * and we don't need it anymore.
+		 * The parsed value has been replaced by the variable, it is
+		 * released along with the stylesheet.
 		 */
 
-		delete value;
-
 		return true;
 	}
 
-	if (value->getType() == kValueTypeFunction && this->evaluateFunction(value, values)) {
+	if (value.getType() == kValueTypeFunction && this->evaluateFunction(value, values)) {
 
 		/*
-		 * The value used to be deleted just like the variable. However, it
-		 * can be quite problematic if one of the function's argument is used
-		 * by the function. For this reason I do not delete the value anymore
+		 * The function's arguments can be part of the result, the value
+		 * is released along with the stylesheet.
 		 */
 
 		return true;
@@ -256,7 +259,7 @@ Parser::parseDescriptor(TokenList& tokens)
 		return nullptr;
 	}
 
-	auto descriptor = new Descriptor();
+	auto descriptor = this->create<Descriptor>();
 
 	this->parseSelector(tokens, descriptor);
 	
@@ -309,15 +312,15 @@ Parser::parseStyleDescriptor(TokenList& tokens)
 	tokens.nextToken();
 	tokens.skipSpace();
 
-	auto descriptor = new Descriptor();
+	auto descriptor = this->create<Descriptor>();
 
-	auto selector = new Selector();
-	auto fragment = new Fragment();
+	auto selector = this->create<Selector>();
+	auto fragment = this->create<Fragment>();
 
 	selector->head = fragment;
 	selector->tail = fragment;
 
-	fragment->styles.push_back(name);
+	fragment->styles.push_back(Atoms::intern(name));
 
 	descriptor->selector = selector;
 
@@ -359,15 +362,15 @@ Parser::parseStateDescriptor(TokenList& tokens)
 	tokens.nextToken();
 	tokens.skipSpace();
 
-	auto descriptor = new Descriptor();
+	auto descriptor = this->create<Descriptor>();
 
-	auto selector = new Selector();
-	auto fragment = new Fragment();
+	auto selector = this->create<Selector>();
+	auto fragment = this->create<Fragment>();
 
 	selector->head = fragment;
 	selector->tail = fragment;
 
-	fragment->states.push_back(name);
+	fragment->states.push_back(Atoms::intern(name));
 
 	descriptor->selector = selector;
 
@@ -407,7 +410,7 @@ Parser::parseVariable(TokenList& tokens)
 
 	this->assertTokenType(tokens, kTokenTypeColon);
 
-	auto variable = new Variable(name);
+	auto variable = this->create<Variable>(name);
 
 	tokens.nextToken();
 	tokens.skipSpace();
@@ -440,7 +443,7 @@ Parser::parseSelector(TokenList& tokens)
 		return nullptr;
 	}
 
-	auto selector = new Selector();
+	auto selector = this->create<Selector>();
 
 	while (true) {
 
@@ -492,26 +495,26 @@ Parser::parseFragment(TokenList& tokens)
 		return nullptr;
 	}
 
-	auto fragment = new Fragment();
+	auto fragment = this->create<Fragment>();
 
 	while (true) {
 
 		switch (tokens.getCurrTokenType()) {
 
 			case kTokenTypeHash:
-				fragment->name = tokens.getCurrTokenName();
+				fragment->name = Atoms::intern(tokens.getCurrTokenName());
 				break;
 
 			case kTokenTypeIdent:
-				fragment->type = tokens.getCurrTokenName();
+				fragment->type = Atoms::intern(tokens.getCurrTokenName());
 				break;
 
 			case kTokenTypeStyleIdent:
-				fragment->styles.push_back(tokens.getCurrTokenName());
+				fragment->styles.push_back(Atoms::intern(tokens.getCurrTokenName()));
 				break;
 
 			case kTokenTypeStateIdent:
-				fragment->states.push_back(tokens.getCurrTokenName());
+				fragment->states.push_back(Atoms::intern(tokens.getCurrTokenName()));
 				break;
 
 			default:
@@ -554,7 +557,7 @@ Parser::parseProperty(TokenList& tokens)
 
 	this->assertTokenType(tokens, kTokenTypeColon);
 
-	auto property = new Property(this->toCamelCase(name));
+	auto property = this->create<Property>(this->toCamelCase(name));
 
 	tokens.nextToken();
 	tokens.skipSpace();
@@ -577,151 +580,151 @@ Parser::parseProperty(TokenList& tokens)
 	return property;
 }
 
-Value*
-Parser::parseValue(TokenList& tokens)
+bool
+Parser::parseValue(TokenList& tokens, Value& value)
 {
 	if (tokens.getCurrTokenType() == kTokenTypeSpace) {
 		tokens.nextToken();
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeIdent) {
-		return this->parseIdentValue(tokens);
+		value = this->parseIdentValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeNumber) {
-		return this->parseNumberValue(tokens);
+		value = this->parseNumberValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeString) {
-		return this->parseStringValue(tokens);
+		value = this->parseStringValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeHash) {
-		return this->parseColorValue(tokens);
+		value = this->parseColorValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeVariable) {
-		return this->parseVariableValue(tokens);
+		value = this->parseVariableValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeFunction) {
-		return this->parseFunctionValue(tokens);
+		value = this->parseFunctionValue(tokens);
+		return true;
 	}
 
 	if (tokens.getCurrTokenType() == kTokenTypeDelimiter ||
 		tokens.getCurrTokenType() == kTokenTypeLinebreak) {
-		return nullptr;
+		return false;
 	}
 
 	this->unexpectedToken(tokens);
 
-	return nullptr;
+	return false;
 }
 
-Value*
+Value
 Parser::parseIdentValue(TokenList& tokens)
 {
 	if (tokens.getCurrToken().hasName("null")) {
-		return new NullValue();
+		return Value::createNull();
 	}
 
 	if (tokens.getCurrToken().hasName("true")) {
-		return new BooleanValue(true);
+		return Value::createBoolean(true);
 	}
 
 	if (tokens.getCurrToken().hasName("false")) {
-		return new BooleanValue(false);
+		return Value::createBoolean(false);
 	}
 
-	return this->parseStringValue(tokens);
+	return this->createIdentValue(tokens.getCurrTokenName());
 }
 
-Value*
+Value
 Parser::parseColorValue(TokenList& tokens)
 {
 	string color;
 	color.append("#");
 	color.append(tokens.getCurrTokenName());
-	return new StringValue(color);
+	return this->createStringValue(color);
 }
 
-Value*
+Value
 Parser::parseStringValue(TokenList& tokens)
 {
-	return new StringValue(tokens.getCurrTokenName());
+	return this->createStringValue(tokens.getCurrTokenName());
 }
 
-Value*
+Value
 Parser::parseNumberValue(TokenList& tokens)
 {
+	auto number = stod(tokens.getCurrTokenName());
+
 	if (tokens.getCurrTokenUnit() == "") {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitNone);
+		return Value::createNumber(number, kValueUnitNone);
 	}
 
 	if (tokens.getCurrTokenUnit() == "%") {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitPC);
+		return Value::createNumber(number, kValueUnitPC);
 	}
 
 	if (tokens.getCurrToken().hasUnit("px")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitPX);
+		return Value::createNumber(number, kValueUnitPX);
 	}
 
 	if (tokens.getCurrToken().hasUnit("vw")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitVW);
+		return Value::createNumber(number, kValueUnitVW);
 	}
 
 	if (tokens.getCurrToken().hasUnit("vh")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitVH);
+		return Value::createNumber(number, kValueUnitVH);
 	}
 
 	if (tokens.getCurrToken().hasUnit("pw")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitPW);
+		return Value::createNumber(number, kValueUnitPW);
 	}
 
 	if (tokens.getCurrToken().hasUnit("ph")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitPH);
+		return Value::createNumber(number, kValueUnitPH);
 	}
 
 	if (tokens.getCurrToken().hasUnit("cw")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitCW);
+		return Value::createNumber(number, kValueUnitCW);
 	}
 
 	if (tokens.getCurrToken().hasUnit("ch")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitCH);
+		return Value::createNumber(number, kValueUnitCH);
 	}
 
 	if (tokens.getCurrToken().hasUnit("deg")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitDeg);
+		return Value::createNumber(number, kValueUnitDeg);
 	}
 
 	if (tokens.getCurrToken().hasUnit("rad")) {
-		return new NumberValue(tokens.getCurrTokenName(), kValueUnitRad);
+		return Value::createNumber(number, kValueUnitRad);
 	}
 
 	this->unexpectedToken(tokens);
 
-	return nullptr;
+	return Value::createNull();
 }
 
-Value*
+Value
 Parser::parseVariableValue(TokenList& tokens)
 {
-	if (tokens.getCurrTokenType() != kTokenTypeVariable) {
-		return nullptr;
-	}
-
-	return new VariableValue(tokens.getCurrTokenName());
+	return Value::createVariable(this->create<VariableValue>(tokens.getCurrTokenName()));
 }
 
-Value*
+Value
 Parser::parseFunctionValue(TokenList& tokens)
 {
-	if (tokens.getCurrTokenType() != kTokenTypeFunction) {
-		return nullptr;
-	}
-
-	auto argument = new Argument();
-	auto function = new FunctionValue(tokens.getCurrTokenName());
+	auto argument = this->create<Argument>();
+	auto function = this->create<FunctionValue>(tokens.getCurrTokenName());
 
 	tokens.nextToken();
 
@@ -759,16 +762,7 @@ Parser::parseFunctionValue(TokenList& tokens)
 
 			auto value = this->parseVariableValue(tokens);
 
-			if (this->evaluateVariable(value, argument->values)) {
-
-				/*
-				 * The parsed value has been replaced by the variable  and we
-				 * don't need it anymore.
-				 */
-
-				delete value;
-
-			} else {
+			if (this->evaluateVariable(value, argument->values) == false) {
 				argument->values.push_back(value);
 			}
 
@@ -780,16 +774,7 @@ Parser::parseFunctionValue(TokenList& tokens)
 
 			auto value = this->parseFunctionValue(tokens);
 
-			if (this->evaluateFunction(value, argument->values)) {
-
-				/*
-				 * The parsed value has been replaced by the variable  and we
-				 * don't need it anymore.
-				 */
-
-				delete value;
-
-			} else {
+			if (this->evaluateFunction(value, argument->values) == false) {
 				argument->values.push_back(value);
 			}
 
@@ -800,7 +785,7 @@ Parser::parseFunctionValue(TokenList& tokens)
 		if (tokens.getCurrTokenType() == kTokenTypeComma) {
 			tokens.nextToken();
 			function->arguments.push_back(argument);
-			argument = new Argument();
+			argument = this->create<Argument>();
 			continue;
 		}
 
@@ -813,27 +798,62 @@ Parser::parseFunctionValue(TokenList& tokens)
 		this->unexpectedToken(tokens);
 	}
 
-	return function;
+	return Value::createFunction(function);
 }
 
 bool
-Parser::evaluateVariable(Value* value, vector<Value*>& result)
+Parser::evaluateVariable(const Value& value, vector<Value>& result)
 {
 	if (this->stylesheet == nullptr) {
 		return false;
 	}
 
-	return value->getType() == kValueTypeVariable ? dynamic_cast<VariableValue*>(value)->evaluate(this->stylesheet, result) : false;
+	return value.getType() == kValueTypeVariable ? value.getVariable()->evaluate(this->stylesheet, result) : false;
 }
 
 bool
-Parser::evaluateFunction(Value* value, vector<Value*>& result)
+Parser::evaluateFunction(const Value& value, vector<Value>& result)
 {
 	if (this->stylesheet == nullptr) {
 		return false;
 	}
 	
-	return value->getType() == kValueTypeFunction ? dynamic_cast<FunctionValue*>(value)->evaluate(this->stylesheet, result) : false;
+	return value.getType() == kValueTypeFunction ? value.getFunction()->evaluate(this->stylesheet, result) : false;
+}
+
+const char*
+Parser::copy(const string& text)
+{
+	if (this->arena) {
+		return this->arena->copy(text);
+	}
+
+	auto data = new char[text.size() + 1];
+	memcpy(data, text.c_str(), text.size() + 1);
+	return data;
+}
+
+Value
+Parser::createIdentValue(const string& name)
+{
+	/*
+	 * The identifiers of a stylesheet are interned so the layout can compare
+	 * them with its keywords. Values parsed on their own keep a copy of the
+	 * text and never grow the atom table.
+	 */
+
+	if (this->arena) {
+		auto atom = Atoms::intern(name);
+		return Value::createString(Atoms::resolve(atom).c_str(), atom);
+	}
+
+	return Value::createString(this->copy(name), Atoms::find(name));
+}
+
+Value
+Parser::createStringValue(const string& text)
+{
+	return Value::createString(this->copy(text), 0);
 }
 
 string
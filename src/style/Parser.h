@@ -11,6 +11,9 @@
 #include "Value.h"
 #include "VariableValue.h"
 #include "FunctionValue.h"
+#include "Arena.h"
+
+#include <utility>
 
 namespace Dezel {
 namespace Style {
@@ -22,11 +25,29 @@ private:
 	Stylesheet* stylesheet;
 	Tokenizer* tokenizer;
 
+	/*
+	 * The parsed objects are created in the arena of the stylesheet. The
+	 * values parsed on their own are allocated individually when there is
+	 * no arena.
+	 */
+
+	Arena* arena;
+
 	string file;
 
 	Parser(Stylesheet* stylesheet, Tokenizer* tokenizer);
 	Parser(Stylesheet* stylesheet, Tokenizer* tokenizer, string file);
-	Parser(vector<Value*>& values, Tokenizer* tokenizer);
+	Parser(vector<Value>& values, Tokenizer* tokenizer, Arena* arena);
+
+	template<typename T, typename... Args>
+	T* create(Args&&... args) {
+		return this->arena ? this->arena->create<T>(std::forward<Args>(args)...) : new T(std::forward<Args>(args)...);
+	}
+
+	const char* copy(const string& text);
+
+	Value createIdentValue(const string& name);
+	Value createStringValue(const string& text);
 
 	bool parse();
 
@@ -39,7 +60,7 @@ private:
 	bool parseSelector(TokenList& tokens, Descriptor* descriptor);
 	bool parseProperty(TokenList& tokens, Descriptor* descriptor);
 
-	bool parseValueAndEvaluate(TokenList& tokens, vector<Value*>& values);
+	bool parseValueAndEvaluate(TokenList& tokens, vector<Value>& values);
 
 	Descriptor* parseDescriptor(TokenList& tokens);
 	Descriptor* parseChildDescriptor(TokenList& tokens);
@@ -53,16 +74,17 @@ private:
 	Fragment* parseFragment(TokenList& tokens);
 	Property* parseProperty(TokenList& tokens);
 
-	Value* parseValue(TokenList& tokens);
-	Value* parseIdentValue(TokenList& tokens);
-	Value* parseColorValue(TokenList& tokens);
-	Value* parseStringValue(TokenList& tokens);
-	Value* parseNumberValue(TokenList& tokens);
-	Value* parseFunctionValue(TokenList& tokens);
-	Value* parseVariableValue(TokenList& tokens);
+	bool parseValue(TokenList& tokens, Value& value);
+
+	Value parseIdentValue(TokenList& tokens);
+	Value parseColorValue(TokenList& tokens);
+	Value parseStringValue(TokenList& tokens);
+	Value parseNumberValue(TokenList& tokens);
+	Value parseFunctionValue(TokenList& tokens);
+	Value parseVariableValue(TokenList& tokens);
 
-	bool evaluateVariable(Value* value, vector<Value*>& result);
-	bool evaluateFunction(Value* value, vector<Value*>& result);
+	bool evaluateVariable(const Value& value, vector<Value>& result);
+	bool evaluateFunction(const Value& value, vector<Value>& result);
 
 	string toCamelCase(string name);
 
@@ -74,7 +96,8 @@ public:
 
 	static void parse(Stylesheet* stylesheet, const string& source);
 	static void parse(Stylesheet* stylesheet, const string& source, const string& url);
-	static void parse(vector<Value*>& values, const string& source);
+	static void parse(vector<Value>& values, const string& source);
+	static void parse(vector<Value>& values, const string& source, Arena* arena);
 
 };
 
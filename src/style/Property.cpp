@@ -1,5 +1,4 @@
 #include "Property.h"
-#include "FunctionValue.h"
 #include "Value.h"
 
 namespace Dezel {
@@ -9,19 +8,19 @@ namespace Style {
 // MARK: Public API
 //------------------------------------------------------------------------------
 
-Property::Property(string name) : name(name)
+Property::Property(string name) : name(name), id(Atoms::intern(name))
 {
 
 }
 
 void
-Property::appendValue(Value* value)
+Property::appendValue(const Value& value)
 {
 	this->values.push_back(value);
 }
 
 void
-Property::insertValue(size_t index, Value* value)
+Property::insertValue(size_t index, const Value& value)
 {
 	this->values.insert(this->values.begin() + index, value);
 }
@@ -44,7 +43,7 @@ Property::toString(int depth)
 	output.append(" ");
 
 	for (auto value : this->values) {
-		output.append(value->toString());
+		output.append(value.toString());
 	}
 
 	return output;
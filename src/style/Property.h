@@ -1,6 +1,9 @@
 #ifndef Property_h
 #define Property_h
 
+#include "Atom.h"
+#include "Value.h"
+
 #include <string>
 #include <vector>
 
@@ -12,14 +15,15 @@ using std::vector;
 
 class Parser;
 class Stylesheet;
-class Value;
 
 class Property {
 
 private:
 
 	string name;
-	vector<Value*> values;
+	vector<Value> values;
+
+	Atom id;
 
 public:
 
@@ -32,12 +36,16 @@ public:
 		return this->name;
 	}
 
-	const vector<Value*>& getValues() const {
+	Atom getId() const {
+		return this->id;
+	}
+
+	const vector<Value>& getValues() const {
 		return this->values;
 	}
 
-	void appendValue(Value* value);
-	void insertValue(size_t index, Value* value);
+	void appendValue(const Value& value);
+	void insertValue(size_t index, const Value& value);
 	void removeValue(size_t index);
 
 	string toString(int depth = 0);
@@ -1,76 +1,102 @@
-
 #include "PropertyList.h"
 
 #include <iostream>
 #include <iterator>
+#include <algorithm>
 
 namespace Dezel {
 namespace Style {
 
-using std::rotate;
+using std::lower_bound;
 using std::distance;
+using std::is_sorted;
+using std::sort;
 
 //------------------------------------------------------------------------------
 // MARK: Private API
 //------------------------------------------------------------------------------
 
+size_t
+PropertyList::search(Atom id) const
+{
+	return distance(
+		this->ids.begin(),
+		lower_bound(
+			this->ids.begin(),
+			this->ids.end(),
+			id
+		)
+	);
+}
+
 void
-PropertyList::diff(const PropertyList& initial, const PropertyList& current, vector<Property*>& inserts, vector<Property*>& updates, vector<Property*>& removes)
+PropertyList::diff(const PropertyList& initial, const PropertyList& current, PropertyDiff& diff)
 {
-	/*
-	 * The initial property list is empty, all items from the
-	 * current will be inserted.
-	 */
+	diff.clear();
 
-	if (initial.size() == 0) {
-		inserts = current.list;
+	if (&initial == &current) {
 		return;
 	}
 
 	/*
-	 * The current property list is empty, all items from the
-	 * initial will be removed
+	 * Both lists are sorted by id, walking them in lockstep finds the
+	 * inserted, updated and removed properties in a single pass.
 	 */
 
-	if (current.size() == 0) {
-		removes = initial.list;
-		return;
-	}
+	auto& inserts = diff.rankedInserts;
+	auto& updates = diff.rankedUpdates;
+	auto& removes = diff.rankedRemoves;
 
-	/*
-	 * Compare the element from the current list. Once completed we will have
-	 * the elements that needs to be removed and these do not need to be
-	 * ordered by their insertion index
-	 */
+	size_t i = 0;
+	size_t j = 0;
 
-	auto remains = initial.data;
+	while (i < initial.size() && j < current.size()) {
 
-	for (auto property : current.list) {
+		auto a = initial.ids[i];
+		auto b = current.ids[j];
 
-		auto key = property->getName();
+		if (a == b) {
 
-		remains.erase(key);
+			if (initial.list[i] != current.list[j]) {
+				updates.emplace_back(current.ranks[j], current.list[j]);
+			}
 
-		if (initial.has(key) == false) {
-			inserts.push_back(property);
+			i++;
+			j++;
 			continue;
 		}
 
-		if (initial.get(key) != property) {
-			updates.push_back(property);
-			continue;
+		if (a < b) {
+			removes.emplace_back(initial.ranks[i], initial.list[i]);
+			i++;
+		} else {
+			inserts.emplace_back(current.ranks[j], current.list[j]);
+			j++;
 		}
 	}
 
+	for (; i < initial.size(); i++) removes.emplace_back(initial.ranks[i], initial.list[i]);
+	for (; j < current.size(); j++) inserts.emplace_back(current.ranks[j], current.list[j]);
+
+	rank(inserts, diff.inserts);
+	rank(updates, diff.updates);
+	rank(removes, diff.removes);
+}
+
+void
+PropertyList::rank(vector<pair<unsigned, Property*>>& ranked, vector<Property*>& properties)
+{
 	/*
-	 * If we were to compare by looping through the initial properties instead
-	 * the code below would contains the insertion. In order to keep the
-	 * proper insertion order, we would have push the properties in the same
-	 * order they appear in the list vector.
+	 * The ranks are unique within a list. Properties declared in the order
+	 * of their ids, which is common, are already sorted.
 	 */
 
-	for (auto property : remains) {
-		removes.push_back(property.second);
+	if (is_sorted(ranked.begin(), ranked.end()) == false) {
+		sort(ranked.begin(), ranked.end());
+	}
+
+	for (auto& entry : ranked) {
+		properties.push_back(entry.second);
 	}
 }
 
@@ -81,66 +107,94 @@ PropertyList::diff(const PropertyList& initial, const PropertyList& current, vec
 void
 PropertyList::add(Property* property)
 {
-	auto name = property->getName();
-
-	if (this->has(name)) {
-	
-		auto dist = distance(this->keys.begin(), find(
-			this->keys.begin(),
-			this->keys.end(),
-			name
-		));
-
-		rotate(
-			this->keys.begin() + dist,
-			this->keys.begin() + dist + 1,
-			this->keys.end()
-		);
-
-		this->list[dist] = property;
-
-		rotate(
-			this->list.begin() + dist,
-			this->list.begin() + dist + 1,
-			this->list.end()
-		);
-
-		this->data[name] = property;
+	auto id = property->getId();
+
+	auto index = this->search(id);
+
+	auto rank = this->sequence++;
+
+	if (index < this->ids.size() &&
+		this->ids[index] == id) {
+		this->list[index] = property;
+		this->ranks[index] = rank;
 		return;
 	}
 
-	this->keys.push_back(name);
-	this->list.push_back(property);
-	this->data[name] = property;
+	this->ids.insert(this->ids.begin() + index, id);
+	this->list.insert(this->list.begin() + index, property);
+	this->ranks.insert(this->ranks.begin() + index, rank);
 }
 
 void
 PropertyList::merge(const PropertyList& dictionary)
 {
 	if (this->size() == 0) {
-		this->keys = dictionary.keys;
+		this->ids = dictionary.ids;
 		this->list = dictionary.list;
-		this->data = dictionary.data;
+		this->ranks = dictionary.ranks;
+		this->sequence = dictionary.sequence;
 		return;
 	}
 
-	for (auto property : dictionary.list) {
-		this->add(property);
+	/*
+	 * Both lists are sorted, they are merged in a single pass and the
+	 * properties of the given list override the ones with the same name.
+	 * They rank after the properties already in the list.
+	 */
+
+	const auto base = this->sequence;
+
+	vector<Atom> ids;
+	vector<Property*> list;
+	vector<unsigned> ranks;
+
+	ids.reserve(this->size() + dictionary.size());
+	list.reserve(this->size() + dictionary.size());
+	ranks.reserve(this->size() + dictionary.size());
+
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < this->size() || j < dictionary.size()) {
+
+		if (j == dictionary.size() || (i < this->size() && this->ids[i] < dictionary.ids[j])) {
+			ids.push_back(this->ids[i]);
+			list.push_back(this->list[i]);
+			ranks.push_back(this->ranks[i]);
+			i++;
+			continue;
+		}
+
+		if (i < this->size() && this->ids[i] == dictionary.ids[j]) {
+			i++;
+		}
+
+		ids.push_back(dictionary.ids[j]);
+		list.push_back(dictionary.list[j]);
+		ranks.push_back(base + dictionary.ranks[j]);
+		j++;
 	}
+
+	this->ids.swap(ids);
+	this->list.swap(list);
+	this->ranks.swap(ranks);
+
+	this->sequence = base + dictionary.sequence;
 }
 
 void
-PropertyList::diffs(const PropertyList& properties, vector<Property*>& inserts, vector<Property*>& updates, vector<Property*>& removes)
+PropertyList::diffs(const PropertyList& properties, PropertyDiff& diff) const
 {
-	PropertyList::diff(*this, properties, inserts, updates, removes);
+	PropertyList::diff(*this, properties, diff);
 }
 
 void
 PropertyList::clear()
 {
-	this->keys.clear();
+	this->ids.clear();
 	this->list.clear();
-	this->data.clear();
+	this->ranks.clear();
+	this->sequence = 0;
 }
 
 }
@@ -1,37 +1,117 @@
 #ifndef PropertyList_h
 #define PropertyList_h
 
+#include "Atom.h"
 #include "Property.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <utility>
+#include <stdexcept>
 
 namespace Dezel {
 namespace Style {
 
+using std::atomic;
+using std::pair;
 using std::string;
 using std::vector;
-using std::unordered_map;
+
+/**
+ * Receives the changes between two property lists. The vectors are cleared
+ * but keep their capacity between diffs so an instance can be reused as a
+ * scratch buffer.
+ */
+struct PropertyDiff {
+
+	vector<Property*> inserts;
+	vector<Property*> updates;
+	vector<Property*> removes;
+
+	/*
+	 * The changes are found in the order of the ids and are given back in
+	 * the order the properties were declared, they are ranked here first.
+	 */
+
+	vector<pair<unsigned, Property*>> rankedInserts;
+	vector<pair<unsigned, Property*>> rankedUpdates;
+	vector<pair<unsigned, Property*>> rankedRemoves;
+
+	bool busy = false;
+
+	bool empty() const {
+		return (
+			this->inserts.empty() &&
+			this->updates.empty() &&
+			this->removes.empty()
+		);
+	}
+
+	void clear() {
+		this->inserts.clear();
+		this->updates.clear();
+		this->removes.clear();
+		this->rankedInserts.clear();
+		this->rankedUpdates.clear();
+		this->rankedRemoves.clear();
+	}
+};
 
 class PropertyList {
 
 private:
 
-	vector<string> keys;
+	/*
+	 * The properties are sorted by the atom of their name, which is kept in
+	 * a separate vector so a lookup does not have to read the properties.
+	 */
+
+	vector<Atom> ids;
 	vector<Property*> list;
-	unordered_map<string, Property*> data;
+
+	/*
+	 * The rank of each property gives the order it was declared in, a
+	 * property declared again moves after the other ones. The host is
+	 * given the changes in that order.
+	 */
+
+	vector<unsigned> ranks;
+
+	unsigned sequence = 0;
+
+	/*
+	 * The merged lists are shared by the nodes and by the matched
+	 * properties cache, the last one to let go of a list deletes it.
+	 */
+
+	mutable atomic<unsigned> references{0};
+
+	size_t search(Atom id) const;
 
 	static void diff(
 		const PropertyList& initial,
 		const PropertyList& current,
-		vector<Property*>& inserts,
-		vector<Property*>& updates,
-		vector<Property*>& removes
+		PropertyDiff& diff
+	);
+
+	static void rank(
+		vector<pair<unsigned, Property*>>& ranked,
+		vector<Property*>& properties
 	);
 
 public:
 
+	void retain() const {
+		this->references++;
+	}
+
+	void release() const {
+		if (--this->references == 0) {
+			delete this;
+		}
+	}
+
 	void add(Property* property);
 
 	Property* get(size_t idx) const {
@@ -39,15 +119,34 @@ public:
 	}
 
 	Property* get(string key) const {
-		return this->data.at(key);
+
+		auto property = this->find(Atoms::find(key));
+
+		if (property == nullptr) {
+			throw std::out_of_range(key);
+		}
+
+		return property;
 	}
 
 	bool has(string key) const {
-		return this->data.find(key) != this->data.end();
+		return this->find(Atoms::find(key)) != nullptr;
+	}
+
+	Property* find(Atom id) const {
+
+		auto index = this->search(id);
+
+		if (index < this->ids.size() &&
+			this->ids[index] == id) {
+			return this->list[index];
+		}
+
+		return nullptr;
 	}
 
 	void merge(const PropertyList& properties);
-	void diffs(const PropertyList& properties, vector<Property*>& inserts, vector<Property*>& updates, vector<Property*>& removes);
+	void diffs(const PropertyList& properties, PropertyDiff& diff) const;
 	void clear();
 
 	//--------------------------------------------------------------------------
@@ -69,6 +168,14 @@ public:
 		return this->list.end();
 	}
 
+	inline const_iterator begin() const noexcept {
+		return this->list.begin();
+	}
+
+	inline const_iterator end() const noexcept {
+		return this->list.end();
+	}
+
 	inline const_iterator cbegin() const noexcept {
 		return this->list.cbegin();
 	}
@@ -0,0 +1,102 @@
+#include "RuleIndex.h"
+#include "Descriptor.h"
+#include "Selector.h"
+#include "Fragment.h"
+#include "DisplayNode.h"
+
+#include <algorithm>
+
+namespace Dezel {
+namespace Style {
+
+using std::sort;
+using std::unique;
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+void
+RuleIndex::collect(const unordered_map<Atom, vector<size_t>>& buckets, Atom key, vector<size_t>& result)
+{
+	auto it = buckets.find(key);
+
+	if (it == buckets.end()) {
+		return;
+	}
+
+	result.insert(
+		result.end(),
+		it->second.begin(),
+		it->second.end()
+	);
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+RuleIndex::add(Descriptor* descriptor, size_t index)
+{
+	auto fragment = descriptor->getSelector()->getTail();
+
+	if (fragment->getName()) {
+		this->names[fragment->getName()].push_back(index);
+		return;
+	}
+
+	/*
+	 * A fragment matches a node that has any of its styles or states, the
+	 * rule must be reachable from each of them.
+	 */
+
+	if (fragment->hasStyle()) {
+		for (auto style : fragment->getStyles()) this->styles[style].push_back(index);
+		return;
+	}
+
+	if (fragment->hasState()) {
+		for (auto state : fragment->getStates()) this->states[state].push_back(index);
+		return;
+	}
+
+	if (fragment->getType()) {
+		this->types[fragment->getType()].push_back(index);
+		return;
+	}
+
+	this->universal.push_back(index);
+}
+
+void
+RuleIndex::collect(DisplayNode* node, vector<size_t>& result) const
+{
+	result.insert(
+		result.end(),
+		this->universal.begin(),
+		this->universal.end()
+	);
+
+	collect(this->names, node->getName(), result);
+
+	for (auto type : node->getTypes()) collect(this->types, type, result);
+	for (auto style : node->getStyles()) collect(this->styles, style, result);
+	for (auto state : node->getStates()) collect(this->states, state, result);
+
+	/*
+	 * The candidates are returned in the order of the stylesheet, without
+	 * duplicates, so they are matched in the same order as when every rule
+	 * was tested.
+	 */
+
+	sort(result.begin(), result.end());
+
+	result.erase(
+		unique(result.begin(), result.end()),
+		result.end()
+	);
+}
+
+}
+}
@@ -0,0 +1,52 @@
+#ifndef RuleIndex_h
+#define RuleIndex_h
+
+#include "Atom.h"
+
+#include <vector>
+#include <unordered_map>
+
+namespace Dezel {
+	class DisplayNode;
+}
+
+namespace Dezel {
+namespace Style {
+
+using std::vector;
+using std::unordered_map;
+
+class Descriptor;
+
+class RuleIndex {
+
+private:
+
+	/*
+	 * The buckets hold positions within the rule descriptors of the
+	 * stylesheet. A rule is filed under a single trait of its tail
+	 * fragment, the one that is the less likely to be shared by many
+	 * nodes, or in the universal bucket when the fragment has none.
+	 */
+
+	unordered_map<Atom, vector<size_t>> names;
+	unordered_map<Atom, vector<size_t>> types;
+	unordered_map<Atom, vector<size_t>> styles;
+	unordered_map<Atom, vector<size_t>> states;
+
+	vector<size_t> universal;
+
+	static void collect(const unordered_map<Atom, vector<size_t>>& buckets, Atom key, vector<size_t>& result);
+
+public:
+
+	void add(Descriptor* descriptor, size_t index);
+
+	void collect(DisplayNode* node, vector<size_t>& result) const;
+
+};
+
+}
+}
+
+#endif
@@ -10,6 +10,12 @@ namespace Style {
 // MARK: Public API
 //------------------------------------------------------------------------------
 
+void
+Selector::compile()
+{
+	this->program.compile(this->tail);
+}
+
 string
 Selector::toString(int depth) const
 {
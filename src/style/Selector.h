@@ -2,6 +2,7 @@
 #define Selector_h
 
 #include "Importance.h"
+#include "SelectorProgram.h"
 
 #include <string>
 
@@ -28,6 +29,8 @@ private:
 	size_t length = 0;
 	size_t offset = 0;
 
+	SelectorProgram program;
+
 public:
 
 	friend class Parser;
@@ -58,6 +61,12 @@ public:
 		return this->offset;
 	}
 
+	const SelectorProgram& getProgram() const {
+		return this->program;
+	}
+
+	void compile();
+
 	string toString(int depth = 0) const;
 };
 
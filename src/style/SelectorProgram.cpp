@@ -0,0 +1,260 @@
+#include "SelectorProgram.h"
+#include "Fragment.h"
+#include "DisplayNode.h"
+
+#include <algorithm>
+
+namespace Dezel {
+namespace Style {
+
+using std::find;
+using std::distance;
+
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+static int matchAtoms(const vector<Atom>& atoms, const SelectorInstruction* beg, const SelectorInstruction* end)
+{
+	int count = 0;
+
+	for (auto it = beg; it != end; it++) {
+		if (find(atoms.begin(), atoms.end(), it->atom) != atoms.end()) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void
+SelectorProgram::emit(SelectorOpcode opcode, unsigned length, Atom atom)
+{
+	this->instructions.push_back({opcode, length, atom});
+}
+
+bool
+SelectorProgram::matchFragment(size_t& pc, DisplayNode* node, Importance& importance, bool& ascend) const
+{
+	/*
+	 * The importance is only added once every test of the fragment passed,
+	 * a fragment can be tried on several nodes before it matches.
+	 */
+
+	Importance i;
+
+	auto instructions = this->instructions.data();
+
+	for (auto ip = pc; ip < this->instructions.size(); ip++) {
+
+		auto& instruction = instructions[ip];
+
+		switch (instruction.opcode) {
+
+			case kSelectorOpcodeMatchName: {
+
+				if (node->getName() != instruction.atom) {
+					return false;
+				}
+
+				break;
+			}
+
+			case kSelectorOpcodeMatchType: {
+
+				/*
+				 * A base type such as View must not override an extended
+				 * type such as Button, a type found first in the node's type
+				 * vector is more important.
+				 */
+
+				auto& types = node->getTypes();
+
+				auto it = find(
+					types.begin(),
+					types.end(),
+					instruction.atom
+				);
+
+				if (it == types.end()) {
+					return false;
+				}
+
+				i.type += static_cast<int>(types.size() - distance(types.begin(), it));
+
+				break;
+			}
+
+			case kSelectorOpcodeMatchStyles: {
+
+				auto count = matchAtoms(
+					node->getStyles(),
+					instructions + ip + 1,
+					instructions + ip + 1 + instruction.length
+				);
+
+				if (count == 0) {
+					return false;
+				}
+
+				i.style += count;
+
+				ip += instruction.length;
+
+				break;
+			}
+
+			case kSelectorOpcodeMatchStates: {
+
+				auto count = matchAtoms(
+					node->getStates(),
+					instructions + ip + 1,
+					instructions + ip + 1 + instruction.length
+				);
+
+				if (count == 0) {
+					return false;
+				}
+
+				i.state += count;
+
+				ip += instruction.length;
+
+				break;
+			}
+
+			case kSelectorOpcodeAtom:
+				break;
+
+			case kSelectorOpcodeAscend:
+			case kSelectorOpcodeStay:
+
+				importance.name += i.name;
+				importance.type += i.type;
+				importance.style += i.style;
+				importance.state += i.state;
+
+				ascend = instruction.opcode == kSelectorOpcodeAscend;
+
+				pc = ip + 1;
+
+				return true;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// MARK: Public API
+//------------------------------------------------------------------------------
+
+void
+SelectorProgram::compile(Fragment* tail)
+{
+	this->instructions.clear();
+	this->importance = Importance();
+
+	for (auto fragment = tail; fragment; fragment = fragment->getParent()) {
+
+		/*
+		 * A fragment without a name matches any node and does not count,
+		 * one without a type matches any view and counts once.
+		 */
+
+		if (fragment->getName()) {
+			this->emit(kSelectorOpcodeMatchName, 0, fragment->getName());
+			this->importance.name += 1;
+		}
+
+		if (fragment->hasStyle()) {
+			this->emit(kSelectorOpcodeMatchStyles, static_cast<unsigned>(fragment->getStyles().size()));
+			for (auto style : fragment->getStyles()) this->emit(kSelectorOpcodeAtom, 0, style);
+		}
+
+		if (fragment->hasState()) {
+			this->emit(kSelectorOpcodeMatchStates, static_cast<unsigned>(fragment->getStates().size()));
+			for (auto state : fragment->getStates()) this->emit(kSelectorOpcodeAtom, 0, state);
+		}
+
+		if (fragment->getType()) {
+			this->emit(kSelectorOpcodeMatchType, 0, fragment->getType());
+		} else {
+			this->importance.type += 1;
+		}
+
+		/*
+		 * A style or state fragment may apply to the same node as the
+		 * fragment that follows it.
+		 */
+
+		auto ascend = (
+			fragment->hasStyle() == false &&
+			fragment->hasState() == false
+		);
+
+		this->emit(ascend ? kSelectorOpcodeAscend : kSelectorOpcodeStay);
+
+		if (fragment == tail) {
+			this->path = this->instructions.size();
+			this->ascend = ascend;
+		}
+	}
+
+	this->instructions.shrink_to_fit();
+}
+
+bool
+SelectorProgram::matchNode(DisplayNode* node, Importance& importance) const
+{
+	size_t pc = 0;
+
+	bool ascend = false;
+
+	return this->matchFragment(pc, node, importance, ascend);
+}
+
+bool
+SelectorProgram::matchPath(DisplayNode* node, Importance& importance) const
+{
+	auto pc = this->path;
+
+	if (this->ascend) {
+		node = node->getParent();
+	}
+
+	while (pc < this->instructions.size()) {
+
+		if (node == nullptr) {
+			return false;
+		}
+
+		bool ascend = false;
+
+		if (this->matchFragment(pc, node, importance, ascend) == false) {
+
+			/*
+			 * The fragment didn't match the current node. The parent node
+			 * is tried next unless the node is the root of an opaque node.
+			 */
+
+			if (node->isOpaque() ||
+				node->isWindow()) {
+				return false;
+			}
+
+			node = node->getParent();
+
+			continue;
+		}
+
+		if (ascend) {
+			node = node->getParent();
+		}
+	}
+
+	return true;
+}
+
+}
+}
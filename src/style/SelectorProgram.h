@@ -0,0 +1,81 @@
+#ifndef SelectorProgram_h
+#define SelectorProgram_h
+
+#include "Atom.h"
+#include "Importance.h"
+
+#include <vector>
+
+namespace Dezel {
+	class DisplayNode;
+}
+
+namespace Dezel {
+namespace Style {
+
+using std::vector;
+
+class Fragment;
+
+enum SelectorOpcode {
+	kSelectorOpcodeMatchName,
+	kSelectorOpcodeMatchType,
+	kSelectorOpcodeMatchStyles,
+	kSelectorOpcodeMatchStates,
+	kSelectorOpcodeAtom,
+	kSelectorOpcodeAscend,
+	kSelectorOpcodeStay,
+};
+
+struct SelectorInstruction {
+	SelectorOpcode opcode;
+	unsigned length;
+	Atom atom;
+};
+
+class SelectorProgram {
+
+private:
+
+	/*
+	 * The fragments of a selector from the tail to the head, each one
+	 * compiled into its tests followed by an instruction that tells whether
+	 * the next fragment starts from the parent node or from the same node.
+	 * The tests of a style or state fragment are followed by the atoms
+	 * they look for.
+	 */
+
+	vector<SelectorInstruction> instructions;
+
+	/*
+	 * The part of the importance that does not depend on the node, such as
+	 * the named fragments, which is added once the whole selector matched.
+	 */
+
+	Importance importance;
+
+	size_t path = 0;
+
+	bool ascend = false;
+
+	void emit(SelectorOpcode opcode, unsigned length = 0, Atom atom = 0);
+
+	bool matchFragment(size_t& pc, DisplayNode* node, Importance& importance, bool& ascend) const;
+
+public:
+
+	const Importance& getImportance() const {
+		return this->importance;
+	}
+
+	void compile(Fragment* tail);
+
+	bool matchNode(DisplayNode* node, Importance& importance) const;
+	bool matchPath(DisplayNode* node, Importance& importance) const;
+
+};
+
+}
+}
+
+#endif
@@ -5,9 +5,6 @@
 #include "Selector.h"
 #include "Fragment.h"
 #include "Value.h"
-#include "StringValue.h"
-#include "NumberValue.h"
-#include "BooleanValue.h"
 #include "Tokenizer.h"
 #include "TokenizerStream.h"
 #include "Parser.h"
@@ -24,136 +21,145 @@ using std::min;
 
 namespace Functions {
 
-static void add(const Function* function, const vector<Argument*>& arguments, vector<Value*>& result)
+static void add(const Function* function, const vector<Argument*>& arguments, vector<Value>& result)
 {
 	if (arguments.size() != 2) {
 		throw InvalidInvocationException("The function `add` requires 2 arguments.");
 	}
 
-	auto aValues = arguments[0]->getValues();
-	auto bValues = arguments[1]->getValues();
+	auto& aValues = arguments[0]->getValues();
+	auto& bValues = arguments[1]->getValues();
 
 	if (aValues.size() > 1 ||
 		bValues.size() > 1) {
 		throw InvalidInvocationException("The function `add` can only add a single value for each parameter.");
 	}
 
-	auto aValue = aValues[0];
-	auto bValue = bValues[0];
+	auto& aValue = aValues[0];
+	auto& bValue = bValues[0];
 
-	if (aValue->getType() != kValueTypeNumber ||
-		bValue->getType() != kValueTypeNumber) {
+	if (aValue.getType() != kValueTypeNumber ||
+		bValue.getType() != kValueTypeNumber) {
 		throw InvalidInvocationException("The function `add` can only add numbers.");
 	}
 
-	auto aNumber = reinterpret_cast<NumberValue*>(aValue);
-	auto bNumber = reinterpret_cast<NumberValue*>(bValue);
-
-	if (aNumber->getUnit() != aNumber->getUnit()) {
+	if (aValue.getUnit() != aValue.getUnit()) {
 		throw InvalidInvocationException("The function `add` can only add a values with the same unit.");
 	}
 
-	result.push_back(new NumberValue(aNumber->getValue() + bNumber->getValue(), aNumber->getUnit()));
+	result.push_back(Value::createNumber(aValue.getNumber() + bValue.getNumber(), aValue.getUnit()));
 }
 
-static void sub(const Function* function, const vector<Argument*>& arguments, vector<Value*>& result)
+static void sub(const Function* function, const vector<Argument*>& arguments, vector<Value>& result)
 {
 	if (arguments.size() != 2) {
 		throw InvalidInvocationException("The function `sub` requires 2 arguments.");
 	}
 
-	auto aValues = arguments[0]->getValues();
-	auto bValues = arguments[1]->getValues();
+	auto& aValues = arguments[0]->getValues();
+	auto& bValues = arguments[1]->getValues();
 
 	if (aValues.size() > 1 ||
 		bValues.size() > 1) {
 		throw InvalidInvocationException("The function `sub` can only add a single value for each parameter.");
 	}
 
-	auto aValue = aValues[0];
-	auto bValue = bValues[0];
+	auto& aValue = aValues[0];
+	auto& bValue = bValues[0];
 
-	if (aValue->getType() != kValueTypeNumber ||
-		bValue->getType() != kValueTypeNumber) {
+	if (aValue.getType() != kValueTypeNumber ||
+		bValue.getType() != kValueTypeNumber) {
 		throw InvalidInvocationException("The function `sub` can only add numbers.");
 	}
 
-	auto aNumber = reinterpret_cast<NumberValue*>(aValue);
-	auto bNumber = reinterpret_cast<NumberValue*>(bValue);
-
-	if (aNumber->getUnit() != aNumber->getUnit()) {
+	if (aValue.getUnit() != aValue.getUnit()) {
 		throw InvalidInvocationException("The function `sub` can only add a values with the same unit.");
 	}
 
-	result.push_back(new NumberValue(aNumber->getValue() - bNumber->getValue(), aNumber->getUnit()));
+	result.push_back(Value::createNumber(aValue.getNumber() - bValue.getNumber(), aValue.getUnit()));
 }
 
-static void min(const Function* function, const vector<Argument*>& arguments, vector<Value*>& result)
+static void min(const Function* function, const vector<Argument*>& arguments, vector<Value>& result)
 {
 	if (arguments.size() != 2) {
 		throw InvalidInvocationException("The function `min` requires 2 arguments.");
 	}
 
-	auto aValues = arguments[0]->getValues();
-	auto bValues = arguments[1]->getValues();
+	auto& aValues = arguments[0]->getValues();
+	auto& bValues = arguments[1]->getValues();
 
 	if (aValues.size() > 1 ||
 		bValues.size() > 1) {
 		throw InvalidInvocationException("The function `min` can only add a single value for each parameter.");
 	}
 
-	auto aValue = aValues[0];
-	auto bValue = bValues[0];
+	auto& aValue = aValues[0];
+	auto& bValue = bValues[0];
 
-	if (aValue->getType() != kValueTypeNumber ||
-		bValue->getType() != kValueTypeNumber) {
+	if (aValue.getType() != kValueTypeNumber ||
+		bValue.getType() != kValueTypeNumber) {
 		throw InvalidInvocationException("The function `min` can only add numbers.");
 	}
 
-	auto aNumber = reinterpret_cast<NumberValue*>(aValue);
-	auto bNumber = reinterpret_cast<NumberValue*>(bValue);
-
-	if (aNumber->getUnit() != aNumber->getUnit()) {
+	if (aValue.getUnit() != aValue.getUnit()) {
 		throw InvalidInvocationException("The function `min` can only add a values with the same unit.");
 	}
 
-	result.push_back(new NumberValue(std::min(aNumber->getValue(), bNumber->getValue()), aNumber->getUnit()));
+	result.push_back(Value::createNumber(std::min(aValue.getNumber(), bValue.getNumber()), aValue.getUnit()));
 }
 
-static void max(const Function* function, const vector<Argument*>& arguments, vector<Value*>& result)
+static void max(const Function* function, const vector<Argument*>& arguments, vector<Value>& result)
 {
 	if (arguments.size() != 2) {
 		throw InvalidInvocationException("The function `max` requires 2 arguments.");
 	}
 
-	auto aValues = arguments[0]->getValues();
-	auto bValues = arguments[1]->getValues();
+	auto& aValues = arguments[0]->getValues();
+	auto& bValues = arguments[1]->getValues();
 
 	if (aValues.size() > 1 ||
 		bValues.size() > 1) {
 		throw InvalidInvocationException("The function `max` can only add a single value for each parameter.");
 	}
 
-	auto aValue = aValues[0];
-	auto bValue = bValues[0];
+	auto& aValue = aValues[0];
+	auto& bValue = bValues[0];
 
-	if (aValue->getType() != kValueTypeNumber ||
-		bValue->getType() != kValueTypeNumber) {
+	if (aValue.getType() != kValueTypeNumber ||
+		bValue.getType() != kValueTypeNumber) {
 		throw InvalidInvocationException("The function `max` can only add numbers.");
 	}
 
-	auto aNumber = reinterpret_cast<NumberValue*>(aValue);
-	auto bNumber = reinterpret_cast<NumberValue*>(bValue);
-
-	if (aNumber->getUnit() != aNumber->getUnit()) {
+	if (aValue.getUnit() != aValue.getUnit()) {
 		throw InvalidInvocationException("The function `max` can only add a values with the same unit.");
 	}
 
-	result.push_back(new NumberValue(std::max(aNumber->getValue(), bNumber->getValue()), aNumber->getUnit()));
+	result.push_back(Value::createNumber(std::max(aValue.getNumber(), bValue.getNumber()), aValue.getUnit()));
 }
 
 }
 
+//------------------------------------------------------------------------------
+// MARK: Private API
+//------------------------------------------------------------------------------
+
+void
+Stylesheet::addInvalidationSets(Descriptor* descriptor)
+{
+	/*
+	 * A style or state used by a fragment other than the tail can change
+	 * the rules matched by the descendants of the node that has it. Styles
+	 * and states only found on tail fragments affect the node itself.
+	 */
+
+	auto tail = descriptor->getSelector()->getTail();
+
+	for (auto fragment = tail->getParent(); fragment; fragment = fragment->getParent()) {
+		for (auto style : fragment->getStyles()) this->styleInvalidations[style].add(tail);
+		for (auto state : fragment->getStates()) this->stateInvalidations[state].add(tail);
+	}
+}
+
 //------------------------------------------------------------------------------
 // MARK: Public API
 //------------------------------------------------------------------------------
@@ -168,17 +174,16 @@ Stylesheet::Stylesheet()
 
 Stylesheet::~Stylesheet()
 {
-	for (auto variable : this->variables) delete variable.second;
 	for (auto function : this->functions) delete function.second;
 }
 
 void
 Stylesheet::setVariable(string name, string value)
 {
-	vector<Value*> values;
-	Parser::parse(values, value);
+	vector<Value> values;
+	Parser::parse(values, value, &this->arena);
 
-	auto variable = new Variable(name);
+	auto variable = this->arena.create<Variable>(name);
 
 	for (auto value : values) {
 		variable->values.push_back(value);
@@ -219,6 +224,11 @@ Stylesheet::addDescriptor(Descriptor* descriptor)
 	}
 
 	if (descriptor->properties.size() > 0) {
+		descriptor->order = this->ruleDescriptors.size();
+		descriptor->getSelector()->compile();
+		descriptor->prepareAncestorKeys();
+		this->addInvalidationSets(descriptor);
+		this->ruleIndex.add(descriptor, this->ruleDescriptors.size());
 		this->ruleDescriptors.push_back(descriptor);
 	}
 
@@ -227,5 +237,29 @@ Stylesheet::addDescriptor(Descriptor* descriptor)
 	}
 }
 
+const InvalidationSet*
+Stylesheet::getStyleInvalidationSet(Atom style) const
+{
+	auto it = this->styleInvalidations.find(style);
+
+	if (it == this->styleInvalidations.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
+const InvalidationSet*
+Stylesheet::getStateInvalidationSet(Atom state) const
+{
+	auto it = this->stateInvalidations.find(state);
+
+	if (it == this->stateInvalidations.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
 }
 }
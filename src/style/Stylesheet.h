@@ -1,9 +1,14 @@
 #ifndef Stylesheet_h
 #define Stylesheet_h
 
+#include "Arena.h"
 #include "Function.h"
 #include "Variable.h"
+#include "RuleIndex.h"
+#include "InvalidationSet.h"
+#include "MatchedPropertiesCache.h"
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -17,23 +22,49 @@ namespace Dezel {
 namespace Dezel {
 namespace Style {
 
+using std::atomic;
 using std::string;
 using std::vector;
 using std::unordered_map;
 
 class Paser;
 class Descriptor;
+class Matches;
+class PropertyList;
 
 class Stylesheet {
 
 private:
 
+	/*
+	 * The descriptors, selectors, properties, values and variables are
+	 * created by the parser in the arena and released with the stylesheet.
+	 */
+
+	Arena arena;
+
 	vector<Descriptor*> rootDescriptors;
 	vector<Descriptor*> ruleDescriptors;
 
+	RuleIndex ruleIndex;
+
+	MatchedPropertiesCache matchedProperties;
+
+	/*
+	 * The nodes point to properties allocated in the arena, they retain
+	 * the stylesheet so it outlives them once the host deletes it.
+	 */
+
+	atomic<unsigned> references{1};
+
+	unordered_map<Atom, InvalidationSet> styleInvalidations;
+	unordered_map<Atom, InvalidationSet> stateInvalidations;
+
 	unordered_map<string, Variable*> variables;
 	unordered_map<string, Function*> functions;
 
+	void addInvalidationSets(Descriptor* descriptor);
+
 public:
 
 	friend class Parser;
@@ -42,6 +73,16 @@ public:
 
 	~Stylesheet();
 
+	void retain() {
+		this->references++;
+	}
+
+	void release() {
+		if (--this->references == 0) {
+			delete this;
+		}
+	}
+
 	void setVariable(string name, string value);
 
 	void evaluate(string source);
@@ -51,6 +92,14 @@ public:
 	void addFunction(Function* function);
 	void addDescriptor(Descriptor* descriptor);
 
+	Arena& getArena() {
+		return this->arena;
+	}
+
+	size_t getMemoryUsage() const {
+		return this->arena.getMemoryUsage();
+	}
+
 	const vector<Descriptor*>& getRootDescriptors() const {
 		return this->rootDescriptors;
 	}
@@ -59,6 +108,17 @@ public:
 		return this->ruleDescriptors;
 	}
 
+	const RuleIndex& getRuleIndex() const {
+		return this->ruleIndex;
+	}
+
+	const PropertyList* getMatchedProperties(const Matches& matches) {
+		return this->matchedProperties.get(matches);
+	}
+
+	const InvalidationSet* getStyleInvalidationSet(Atom style) const;
+	const InvalidationSet* getStateInvalidationSet(Atom state) const;
+
 	const unordered_map<string, Variable*>& getVariables() const {
 		return this->variables;
 	}
@@ -1,22 +1,131 @@
 #include "Value.h"
-
-
+#include "FunctionValue.h"
+#include "VariableValue.h"
 
 namespace Dezel {
 namespace Style {
 
+using std::to_string;
+
 //------------------------------------------------------------------------------
 // MARK: Public API
 //------------------------------------------------------------------------------
 
-Value::~Value()
+Value
+Value::createNull()
+{
+	return Value();
+}
+
+Value
+Value::createBoolean(bool boolean)
+{
+	Value value;
+	value.type = kValueTypeBoolean;
+	value.boolean = boolean;
+	return value;
+}
+
+Value
+Value::createNumber(double number, ValueUnit unit)
+{
+	Value value;
+	value.type = kValueTypeNumber;
+	value.unit = unit;
+	value.number = number;
+	return value;
+}
+
+Value
+Value::createString(const char* text, Atom atom)
+{
+	Value value;
+	value.type = kValueTypeString;
+	value.atom = atom;
+	value.text = text;
+	return value;
+}
+
+Value
+Value::createFunction(FunctionValue* function)
 {
+	Value value;
+	value.type = kValueTypeFunction;
+	value.function = function;
+	return value;
+}
 
+Value
+Value::createVariable(VariableValue* variable)
+{
+	Value value;
+	value.type = kValueTypeVariable;
+	value.variable = variable;
+	return value;
 }
 
-Value::Value(ValueType type, ValueUnit unit) : type(type), unit(unit)
+string
+Value::toString() const
 {
-	
+	switch (this->type) {
+
+		case kValueTypeNull:
+			return "null";
+
+		case kValueTypeBoolean:
+			return to_string(this->boolean);
+
+		case kValueTypeString:
+			return this->text;
+
+		case kValueTypeFunction:
+			return this->function->toString();
+
+		case kValueTypeVariable:
+			return this->variable->toString();
+
+		case kValueTypeNumber:
+			break;
+	}
+
+	string output = to_string(this->number);
+
+	switch (this->unit) {
+		case kValueUnitNone:
+			break;
+		case kValueUnitPC:
+			output.append("%");
+			break;
+		case kValueUnitPX:
+			output.append("px");
+			break;
+		case kValueUnitVW:
+			output.append("vw");
+			break;
+		case kValueUnitVH:
+			output.append("vh");
+			break;
+		case kValueUnitPW:
+			output.append("pw");
+			break;
+		case kValueUnitPH:
+			output.append("ph");
+			break;
+		case kValueUnitCW:
+			output.append("cw");
+			break;
+		case kValueUnitCH:
+			output.append("ch");
+			break;
+		case kValueUnitDeg:
+			output.append("deg");
+			break;
+		case kValueUnitRad:
+			output.append("rad");
+			break;
+	}
+
+	return output;
 }
 
 }
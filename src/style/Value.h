@@ -2,6 +2,7 @@
 #define Value_h
 
 #include "DisplayBase.h"
+#include "Atom.h"
 
 #include <string>
 #include <vector>
@@ -14,39 +15,88 @@ using std::vector;
 
 class Parser;
 class Stylesheet;
-class StringValue;
-class NumberValue;
-class BooleanValue;
 class FunctionValue;
 class VariableValue;
 
 class Value {
 
-protected:
+private:
+
+	/*
+	 * A value is a tag, a unit and a payload that fits in 16 bytes so it
+	 * can be stored inline in the value vectors. A string points to text
+	 * owned by the stylesheet arena, by the value list it was parsed in or
+	 * by the atom table, identifiers keep their atom in place of the unit.
+	 * The functions and variables that could not be evaluated while parsing
+	 * point to their own object.
+	 */
 
 	ValueType type;
-	ValueUnit unit;
+
+	union {
+		ValueUnit unit;
+		Atom atom;
+	};
+
+	union {
+		double number;
+		bool boolean;
+		const char* text;
+		FunctionValue* function;
+		VariableValue* variable;
+	};
 
 public:
 
 	friend class Parser;
 	friend class Stylesheet;
 
-	Value(ValueType type, ValueUnit unit);
+	static Value createNull();
+	static Value createBoolean(bool boolean);
+	static Value createNumber(double number, ValueUnit unit);
+	static Value createString(const char* text, Atom atom);
+	static Value createFunction(FunctionValue* function);
+	static Value createVariable(VariableValue* variable);
 
-	virtual ~Value();
+	Value() : type(kValueTypeNull), unit(kValueUnitNone), number(0) {}
 
 	ValueType getType() const {
 		return this->type;
 	}
 
 	ValueUnit getUnit() const {
-		return this->unit;
+		return this->type == kValueTypeString ? kValueUnitNone : this->unit;
+	}
+
+	double getNumber() const {
+		return this->number;
+	}
+
+	bool getBoolean() const {
+		return this->boolean;
+	}
+
+	Atom getAtom() const {
+		return this->type == kValueTypeString ? this->atom : 0;
+	}
+
+	const char* getString() const {
+		return this->text;
+	}
+
+	FunctionValue* getFunction() const {
+		return this->function;
+	}
+
+	VariableValue* getVariable() const {
+		return this->variable;
 	}
 
-	virtual string toString() = 0;
+	string toString() const;
 };
 
+static_assert(sizeof(Value) == 16, "Value must fit in 16 bytes");
+
 }
 }
 
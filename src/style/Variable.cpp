@@ -23,7 +23,7 @@ Variable::toString()
 	output.append(" ");
 
 	for (auto value : this->  values) {
-		output.append(value->toString());
+		output.append(value.toString());
 		output.append(" ");
 	}
 
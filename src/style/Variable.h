@@ -20,7 +20,7 @@ class Variable {
 private:
 
 	string name;
-	vector<Value*> values;
+	vector<Value> values;
 
 public:
 
@@ -29,7 +29,7 @@ public:
 
 	Variable(string name);
 
-	const vector<Value*>& getValues() const {
+	const vector<Value>& getValues() const {
 		return this->values;
 	}
 
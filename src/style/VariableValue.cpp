@@ -8,7 +8,7 @@ namespace Style {
 // MARK: Public API
 //------------------------------------------------------------------------------
 
-VariableValue::VariableValue(string name) : Value(kValueTypeVariable, kValueUnitNone), name(name)
+VariableValue::VariableValue(string name) : name(name)
 {
 
 }
@@ -19,7 +19,7 @@ VariableValue::~VariableValue()
 }
 
 bool
-VariableValue::evaluate(Stylesheet* stylesheet, vector<Value*>& result)
+VariableValue::evaluate(Stylesheet* stylesheet, vector<Value>& result)
 {
 	auto variable = stylesheet->getVariable(this->name);
 
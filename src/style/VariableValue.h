@@ -13,7 +13,7 @@ using std::string;
 class Parser;
 class Stylesheet;
 
-class VariableValue : public Value {
+class VariableValue {
 
 private:
 
@@ -31,7 +31,7 @@ public:
 		return this->name;
 	}
 
-	bool evaluate(Stylesheet* stylesheet, vector<Value*>& result);
+	bool evaluate(Stylesheet* stylesheet, vector<Value>& result);
 
 	string toString();
 };